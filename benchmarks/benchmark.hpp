@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <sys/types.h>
+
+namespace Benchmark
+{
+    template <class Function>
+    double measure(Function function, const uint32_t repetitions = 1)
+    {
+        double fastest = std::numeric_limits<double>::max();
+        for (uint32_t i = 0; i < repetitions; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            fastest = std::min(fastest, elapsed.count());
+        }
+        return fastest;
+    }
+
+    inline void printHeader(const std::string &title)
+    {
+        std::cout << "\n" << title << "\n" << std::string(title.size(), '-') << "\n";
+    }
+
+    inline void printRow(const std::string &name, const std::string &unit, double value)
+    {
+        std::cout << std::left << std::setw(48) << name << std::right << std::setw(16)
+                  << std::fixed << std::setprecision(2) << value << " " << unit << "\n";
+    }
+
+    void sendOverLoopback(const std::string &message, uint port);
+
+    void socketSourceBenchmark();
+    void fileSourceBenchmark();
+    void lexicalAnalyzerBenchmark();
+    void sourceLexingBenchmark();
+    void pipelineBenchmark();
+    void matrixBenchmark();
+}
@@ -0,0 +1,176 @@
+#include "corpusGenerator.hpp"
+
+namespace
+{
+    const char *const IDENTIFIERS[] = {"counter", "first", "second", "result", "weights", "index",
+                                       "accumulator", "limit", "row", "column", "scale", "offset"};
+    const char *const WORDS[] = {"compute", "the", "weighted", "sum", "of", "every", "row", "before",
+                                 "scaling", "result", "matrix", "value", "until", "limit", "reached"};
+}
+
+std::string Benchmark::CorpusGenerator::generate()
+{
+    corpus.clear();
+    corpus.reserve(options.size + (64 << 10));
+    while (corpus.size() < options.size)
+        appendFunction();
+    return std::move(corpus);
+}
+
+uint32_t Benchmark::CorpusGenerator::pick(uint32_t bound)
+{
+    return std::uniform_int_distribution<uint32_t>(0, bound - 1)(random);
+}
+
+std::string Benchmark::CorpusGenerator::identifier()
+{
+    return std::string(IDENTIFIERS[pick(std::size(IDENTIFIERS))]) + std::to_string(pick(16));
+}
+
+void Benchmark::CorpusGenerator::appendFunction()
+{
+    appendComment(0);
+    corpus += "function integer compute" + std::to_string(functionCount++) + "(integer first, double second):\n";
+    appendBlock(1);
+    appendIndent(1);
+    corpus += "return first\n";
+}
+
+void Benchmark::CorpusGenerator::appendBlock(uint32_t depth)
+{
+    uint32_t statementCount = 2 + pick(4);
+    for (uint32_t i = 0; i < statementCount; ++i)
+        appendStatement(depth);
+}
+
+void Benchmark::CorpusGenerator::appendStatement(uint32_t depth)
+{
+    switch (pick(depth < options.maxIndentDepth ? 8 : 5))
+    {
+    case 0:
+        appendMatrix(depth);
+        break;
+    case 1:
+        appendIndent(depth);
+        corpus += "text " + identifier() + " = ";
+        appendString();
+        corpus += "\n";
+        break;
+    case 2:
+        appendComment(depth);
+        break;
+    case 3:
+    case 4:
+        appendIndent(depth);
+        corpus += identifier() + " = ";
+        appendExpression();
+        corpus += pick(4) ? "\n" : " // inline note\n";
+        break;
+    case 5:
+        appendIndent(depth);
+        corpus += "if(" + identifier() + " >= ";
+        appendNumber();
+        corpus += " and not " + identifier() + " == ";
+        appendNumber();
+        corpus += "):\n";
+        appendBlock(depth + 1);
+        break;
+    case 6:
+        appendIndent(depth);
+        corpus += "asLongAs(" + identifier() + " < ";
+        appendNumber();
+        corpus += "):\n";
+        appendBlock(depth + 1);
+        break;
+    default:
+        appendIndent(depth);
+        corpus += "loop(1:" + identifier() + "):\n";
+        appendBlock(depth + 1);
+        break;
+    }
+}
+
+void Benchmark::CorpusGenerator::appendIndent(uint32_t depth)
+{
+    corpus.append(depth * 4, ' ');
+}
+
+void Benchmark::CorpusGenerator::appendMatrix(uint32_t depth)
+{
+    appendIndent(depth);
+    corpus += "matrix[" + std::to_string(options.matrixRows) + "][" + std::to_string(options.matrixColumns) +
+              "] " + identifier() + " = ";
+    for (uint32_t row = 0; row < options.matrixRows; ++row)
+    {
+        corpus += "[";
+        for (uint32_t column = 0; column < options.matrixColumns; ++column)
+        {
+            if (column)
+                corpus += ", ";
+            appendNumber();
+        }
+        corpus += "]";
+    }
+    corpus += "\n";
+}
+
+void Benchmark::CorpusGenerator::appendNumber()
+{
+    switch (pick(6))
+    {
+    case 0:
+    case 1:
+        corpus += std::to_string(pick(100000));
+        break;
+    case 2:
+        corpus += std::to_string(pick(1000)) + "." + std::to_string(pick(100000));
+        break;
+    case 3:
+        corpus += std::to_string(pick(10)) + "." + std::to_string(pick(1000)) + "e-" + std::to_string(pick(12));
+        break;
+    case 4:
+    {
+        char hex[16];
+        snprintf(hex, sizeof hex, "0x%X", pick(1 << 24));
+        corpus += hex;
+        break;
+    }
+    default:
+        corpus += std::to_string(pick(10));
+        break;
+    }
+}
+
+void Benchmark::CorpusGenerator::appendExpression()
+{
+    const char *const OPERATORS[] = {" + ", " - ", " * ", " / "};
+    corpus += identifier();
+    uint32_t operandCount = 1 + pick(4);
+    for (uint32_t i = 0; i < operandCount; ++i)
+    {
+        corpus += OPERATORS[pick(std::size(OPERATORS))];
+        if (pick(2))
+            appendNumber();
+        else
+            corpus += identifier();
+    }
+}
+
+void Benchmark::CorpusGenerator::appendComment(uint32_t depth)
+{
+    appendIndent(depth);
+    corpus += pick(2) ? "#" : "//";
+    size_t end = corpus.size() + options.commentLength / 2 + pick(options.commentLength);
+    while (corpus.size() < end)
+        corpus += std::string(" ") + WORDS[pick(std::size(WORDS))];
+    corpus += "\n";
+}
+
+void Benchmark::CorpusGenerator::appendString()
+{
+    corpus += "'";
+    size_t end = corpus.size() + options.stringLength / 2 + pick(options.stringLength);
+    while (corpus.size() < end)
+        corpus += std::string(WORDS[pick(std::size(WORDS))]) + " ";
+    corpus += "'";
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+
+namespace Benchmark
+{
+    struct CorpusOptions
+    {
+        size_t size = 16 << 20;
+        uint32_t seed = 2021;
+        uint32_t maxIndentDepth = 8;
+        uint32_t matrixRows = 4;
+        uint32_t matrixColumns = 8;
+        uint32_t stringLength = 96;
+        uint32_t commentLength = 120;
+    };
+
+    class CorpusGenerator
+    {
+    public:
+        CorpusGenerator(const CorpusOptions &options) : options(options), random(options.seed) {}
+        std::string generate();
+
+    private:
+        void appendFunction();
+        void appendBlock(uint32_t depth);
+        void appendStatement(uint32_t depth);
+        void appendIndent(uint32_t depth);
+        void appendMatrix(uint32_t depth);
+        void appendNumber();
+        void appendExpression();
+        void appendComment(uint32_t depth);
+        void appendString();
+        std::string identifier();
+        uint32_t pick(uint32_t bound);
+        const CorpusOptions options;
+        std::mt19937 random;
+        std::string corpus;
+        uint32_t functionCount = 0;
+    };
+}
@@ -0,0 +1,54 @@
+#include <cstdio>
+#include "benchmark.hpp"
+#include "source.hpp"
+
+namespace
+{
+    const size_t FILE_SIZE = 64 << 20;
+
+    std::string writeFile()
+    {
+        std::string path = std::filesystem::temp_directory_path() / "tkomFileSourceBenchmark.mpp";
+        std::ofstream file(path);
+        size_t written = 0;
+        const std::string line = "matrix[2][3] matrix1 = [1,2,3,4,5,6] // macierz\n";
+        while (written < FILE_SIZE)
+        {
+            file << line;
+            written += line.size();
+        }
+        return path;
+    }
+
+    double drain(SourceBase &source)
+    {
+        return Benchmark::measure([&] {
+            source.open();
+            while (source.getChar().nextLetter != '\0')
+                ;
+        });
+    }
+}
+
+void Benchmark::fileSourceBenchmark()
+{
+    const std::string path = writeFile();
+    const double megabytes = FILE_SIZE / double(1 << 20);
+    printHeader("File sources, " + std::to_string(FILE_SIZE >> 20) + " MB");
+    {
+        FileSource source(path);
+        printRow("FileSource: throughput", "MB/s", megabytes / drain(source));
+    }
+    {
+        MappedFileSource source(path);
+        printRow("MappedFileSource: throughput", "MB/s", megabytes / drain(source));
+    }
+    {
+        ReadAheadFileSource source(path);
+        printRow("ReadAheadFileSource: throughput", "MB/s", megabytes / drain(source));
+        printRow("ReadAheadFileSource: time in read()", "ms", source.getReadTime().count() / 1e6);
+        printRow("ReadAheadFileSource: consumer stalled", "ms", source.getStallTime().count() / 1e6);
+        printRow("ReadAheadFileSource: I/O time hidden", "ms", source.getHiddenIoTime().count() / 1e6);
+    }
+    std::remove(path.c_str());
+}
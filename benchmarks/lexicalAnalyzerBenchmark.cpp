@@ -0,0 +1,251 @@
+#include "benchmark.hpp"
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+#include "lexical_analyzer/incrementalLexer.hpp"
+#include "lexical_analyzer/tokenLookahead.hpp"
+#include "lexical_analyzer/tokenGenerator.hpp"
+
+namespace
+{
+    const size_t PROGRAM_SIZE = 16 << 20;
+
+    std::string buildProgram()
+    {
+        const std::string block =
+            "function integer compute(integer first, double second):\n"
+            "    matrix[2][3] matrix1 = [1,2,3][4,5,6]\n"
+            "    text label = 'computed value'\n"
+            "    # accumulate until the limit is reached\n"
+            "    asLongAs(first <= 1000 and not second == 3.75):\n"
+            "        first = first + 17 * second - 2\n"
+            "        if(first >= 250):\n"
+            "            break\n"
+            "    return first\n"
+            "// end of function\n";
+        std::string program;
+        program.reserve(PROGRAM_SIZE + block.size());
+        while (program.size() < PROGRAM_SIZE)
+            program += block;
+        return program;
+    }
+
+    std::string buildRepeated(const std::string &line)
+    {
+        std::string program;
+        program.reserve(PROGRAM_SIZE + line.size());
+        while (program.size() < PROGRAM_SIZE)
+            program += line;
+        return program;
+    }
+
+    double lexingSeconds(const std::string &program,
+                         LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep)
+    {
+        return Benchmark::measure([&] {
+            StringSource source(program);
+            LexicalAnalyzer lexicalAnalyzer(source, commentMode);
+            while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+                ;
+        }, 5);
+    }
+
+    void scannerBenchmark(const std::string &program, double megabytes)
+    {
+        const std::pair<Scanner::Kernel, const char *> kernels[] = {
+            {Scanner::Kernel::Scalar, "findLineEnd scalar"},
+            {Scanner::Kernel::SSE2, "findLineEnd SSE2"},
+            {Scanner::Kernel::AVX2, "findLineEnd AVX2"},
+        };
+        for (const auto &[kernel, name] : kernels)
+        {
+            if (kernel > Scanner::bestKernel())
+                continue;
+            uint64_t lineCount = 0;
+            double seconds = Benchmark::measure([&] {
+                lineCount = 0;
+                for (size_t position = Scanner::findLineEnd(program, 0, kernel); position < program.size();
+                     position = Scanner::findLineEnd(program, position + 1, kernel))
+                    ++lineCount;
+            }, 5);
+            Benchmark::printRow(name, "MB/s", megabytes / seconds);
+        }
+    }
+
+    void incrementalBenchmark(const std::string &program)
+    {
+        Benchmark::printHeader("Incremental re-lexing, " + std::to_string(program.size() >> 20) + " MB");
+        double seconds = Benchmark::measure([&] { IncrementalLexer incrementalLexer(program); });
+        Benchmark::printRow("initial lexing", "ms", seconds * 1e3);
+        IncrementalLexer incrementalLexer(program);
+        const uint32_t editCount = 100;
+        const size_t renamed = program.find("first <= 1000", program.size() / 2);
+        seconds = Benchmark::measure([&] {
+            for (uint32_t i = 0; i < editCount; ++i)
+                incrementalLexer.edit(renamed, 5, i % 2 ? "first" : "total");
+        }, 5);
+        Benchmark::printRow("rename identifier", "us/edit", seconds / editCount * 1e6);
+        const size_t indented = program.find("        first = first", program.size() / 2);
+        seconds = Benchmark::measure([&] {
+            for (uint32_t i = 0; i < editCount; ++i)
+            {
+                if (i % 2)
+                    incrementalLexer.edit(indented, 4, "");
+                else
+                    incrementalLexer.edit(indented, 0, "    ");
+            }
+        }, 5);
+        Benchmark::printRow("change indentation", "us/edit", seconds / editCount * 1e6);
+    }
+}
+
+void Benchmark::lexicalAnalyzerBenchmark()
+{
+    const std::string program = buildProgram();
+    const double megabytes = program.size() / double(1 << 20);
+    printHeader("LexicalAnalyzer over StringSource, " + std::to_string(program.size() >> 20) + " MB");
+    uint64_t tokenCount = 0;
+    double seconds = measure([&] {
+        StringSource source(program);
+        LexicalAnalyzer lexicalAnalyzer(source);
+        tokenCount = 0;
+        while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+            ++tokenCount;
+    }, 5);
+    printRow("throughput", "MB/s", megabytes / seconds);
+    printRow("tokens", "Mtokens/s", tokenCount / seconds / 1e6);
+    seconds = measure([&] {
+        StringSource source(program);
+        LexicalAnalyzer lexicalAnalyzer(source);
+        TokenLookahead<8> lookahead(lexicalAnalyzer);
+        while (lookahead.peek(2).getType() != Token::TokenType::EndOfFileToken)
+        {
+            lookahead.mark();
+            lookahead.consume();
+            lookahead.rewind();
+            lookahead.consume();
+        }
+    }, 5);
+    printRow("TokenLookahead<8>, peek(2) and rewind", "MB/s", megabytes / seconds);
+    seconds = measure([&] {
+        StringSource source(program);
+        TokenGenerator generator = generateTokens(source);
+        while (generator.next())
+            ;
+    }, 5);
+    printRow("generateTokens coroutine", "MB/s", megabytes / seconds);
+    seconds = measure([&] {
+        TokenFeed feed;
+        for (size_t offset = 0; offset < program.size(); offset += 1 << 16)
+        {
+            feed.push(std::string_view(program).substr(offset, 1 << 16));
+            while (feed.next())
+                ;
+        }
+        feed.finish();
+        while (feed.next())
+            ;
+    }, 5);
+    printRow("TokenFeed, 64 KB pushes", "MB/s", megabytes / seconds);
+
+    printHeader("Token storage, " + std::to_string(program.size() >> 20) + " MB");
+    size_t storedBytes = 0;
+    seconds = measure([&] {
+        StringSource source(program);
+        LexicalAnalyzer lexicalAnalyzer(source);
+        std::vector<Token> tokens;
+        for (auto token = lexicalAnalyzer.getToken(); token->getType() != Token::TokenType::EndOfFileToken;
+             token = lexicalAnalyzer.getToken())
+            tokens.push_back(std::move(*token));
+        storedBytes = tokens.size() * sizeof(Token);
+    }, 5);
+    printRow("std::vector<Token>", "MB/s", megabytes / seconds);
+    printRow("std::vector<Token> footprint", "MB", storedBytes / double(1 << 20));
+    seconds = measure([&] {
+        StringSource source(program);
+        LexicalAnalyzer lexicalAnalyzer(source);
+        std::vector<CompactToken> tokens;
+        for (auto token = lexicalAnalyzer.getCompactToken(); token->type != Token::TokenType::EndOfFileToken;
+             token = lexicalAnalyzer.getCompactToken())
+            tokens.push_back(*token);
+        storedBytes = tokens.size() * sizeof(CompactToken);
+    }, 5);
+    printRow("std::vector<CompactToken>", "MB/s", megabytes / seconds);
+    printRow("std::vector<CompactToken> footprint", "MB", storedBytes / double(1 << 20));
+
+    TokenStream stream;
+    seconds = measure([&] {
+        StringSource source(program);
+        LexicalAnalyzer lexicalAnalyzer(source);
+        lexicalAnalyzer.tokenizeAll(stream);
+    }, 5);
+    printRow("tokenizeAll into TokenStream", "MB/s", megabytes / seconds);
+    uint64_t identifierCount = 0;
+    seconds = measure([&] {
+        identifierCount = std::count(stream.getTypes().begin(), stream.getTypes().end(),
+                                     Token::TokenType::IdentifierToken);
+    }, 5);
+    printRow("TokenStream type scan", "Mtokens/s", stream.size() / seconds / 1e6);
+    printRow("identifiers found by scan", "tokens", identifierCount);
+
+    const std::string commentHeavy = buildRepeated(
+        "# a long explanatory comment describing what the following statement is meant to compute\n"
+        "counter = counter + 1 // and a trailing comment that keeps going for quite a while\n");
+    const std::string stringHeavy = buildRepeated(
+        "text message = 'a fairly long string literal used as a label in generated scripts'\n");
+    printHeader("Comment and string heavy scripts, " + std::to_string(PROGRAM_SIZE >> 20) + " MB");
+    printRow("comment heavy", "MB/s", commentHeavy.size() / double(1 << 20) / lexingSeconds(commentHeavy));
+    printRow("comment heavy, comments discarded", "MB/s",
+             commentHeavy.size() / double(1 << 20) / lexingSeconds(commentHeavy, LexicalAnalyzer::CommentMode::Discard));
+    printRow("string heavy", "MB/s", stringHeavy.size() / double(1 << 20) / lexingSeconds(stringHeavy));
+    scannerBenchmark(commentHeavy, commentHeavy.size() / double(1 << 20));
+
+    const std::string numberDense = buildRepeated(
+        "values = [12, 3.75, 987654321, 42.125, 65535, 0.0625][7, 8, 9, 10, 11, 3.14159265358979]\n");
+    const std::string notationDense = buildRepeated(
+        "values = [0x1F, 1.5e-3, 0xFFFF, 6.02214076e23, 2E+8, 0x7fffffff]\n");
+    printHeader("Number dense scripts, " + std::to_string(PROGRAM_SIZE >> 20) + " MB");
+    printRow("decimal literals", "MB/s", numberDense.size() / double(1 << 20) / lexingSeconds(numberDense));
+    printRow("hex and exponent literals", "MB/s", notationDense.size() / double(1 << 20) / lexingSeconds(notationDense));
+
+    const std::string script = "integer count = 99999999999999999999\n"
+                               "text name = 'unterminated\n"
+                               "double ratio = 1.5e\n"
+                               "count = count + 1\n";
+    const uint32_t scriptCount = 20000;
+    uint64_t errorCount = 0;
+    printHeader("Validating " + std::to_string(scriptCount) + " malformed scripts");
+    seconds = measure([&] {
+        errorCount = 0;
+        for (uint32_t i = 0; i < scriptCount; ++i)
+        {
+            StringSource source(script);
+            LexicalAnalyzer lexicalAnalyzer(source);
+            try
+            {
+                while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+                    ;
+            }
+            catch (Exception &)
+            {
+                ++errorCount;
+            }
+        }
+    }, 5);
+    printRow("throwing, first error only", "scripts/s", scriptCount / seconds);
+    seconds = measure([&] {
+        errorCount = 0;
+        for (uint32_t i = 0; i < scriptCount; ++i)
+        {
+            StringSource source(script);
+            LexicalAnalyzer lexicalAnalyzer(source, LexicalAnalyzer::CommentMode::Discard,
+                                            LexicalAnalyzer::ErrorMode::Collect);
+            while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+                ;
+            errorCount += lexicalAnalyzer.getDiagnostics().size();
+        }
+    }, 5);
+    printRow("collecting, all errors", "scripts/s", scriptCount / seconds);
+    printRow("diagnostics collected", "errors", errorCount);
+
+    incrementalBenchmark(program.substr(0, program.find('\n', 1 << 20) + 1));
+    incrementalBenchmark(program);
+}
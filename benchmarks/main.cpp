@@ -0,0 +1,32 @@
+#include <functional>
+#include <map>
+#include "benchmark.hpp"
+
+int main(int argc, char *argv[])
+{
+    const std::map<std::string, std::function<void()>> suites = {
+        {"socket", Benchmark::socketSourceBenchmark},
+        {"file", Benchmark::fileSourceBenchmark},
+        {"lexer", Benchmark::lexicalAnalyzerBenchmark},
+        {"sources", Benchmark::sourceLexingBenchmark},
+        {"pipeline", Benchmark::pipelineBenchmark},
+        {"matrix", Benchmark::matrixBenchmark},
+    };
+    if (argc == 1)
+    {
+        for (const auto &[name, suite] : suites)
+            suite();
+        return 0;
+    }
+    for (int i = 1; i < argc; ++i)
+    {
+        auto suite = suites.find(argv[i]);
+        if (suite == suites.end())
+        {
+            std::cout << "Unknown benchmark suite " << argv[i] << ". Available: file lexer matrix pipeline socket sources\n";
+            return 1;
+        }
+        suite->second();
+    }
+    return 0;
+}
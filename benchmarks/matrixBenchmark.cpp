@@ -0,0 +1,74 @@
+#include <functional>
+#include <vector>
+#include "benchmark.hpp"
+#include "matrix.hpp"
+#include "matrixKernels.hpp"
+
+namespace
+{
+
+    const char *kernelName(MatrixKernels::Kernel kernel)
+    {
+        switch (kernel)
+        {
+        case MatrixKernels::Kernel::AVX2:
+            return "AVX2";
+        case MatrixKernels::Kernel::SSE2:
+            return "SSE2";
+        default:
+            return "scalar";
+        }
+    }
+
+    // Every element is read from both operands and written once.
+    void reportBandwidth(const std::string &name, size_t elementCount, uint32_t streams,
+                         const std::function<void()> &run)
+    {
+        double seconds = Benchmark::measure(run, 5);
+        Benchmark::printRow(name, "GB/s", elementCount * sizeof(int64_t) * streams / seconds / 1e9);
+    }
+
+    template <class T>
+    void kernelRows(const std::string &type, const Matrix &lhs, const Matrix &rhs, Matrix &result)
+    {
+        std::span<const T> left = lhs.getValues<T>();
+        std::span<const T> right = rhs.getValues<T>();
+        std::span<T> output = result.getValues<T>();
+        std::vector<MatrixKernels::Kernel> kernels{MatrixKernels::Kernel::Scalar};
+        if (MatrixKernels::bestKernel() != MatrixKernels::Kernel::Scalar)
+            kernels.push_back(MatrixKernels::Kernel::SSE2);
+        if (MatrixKernels::bestKernel() == MatrixKernels::Kernel::AVX2)
+            kernels.push_back(MatrixKernels::Kernel::AVX2);
+        for (MatrixKernels::Kernel kernel : kernels)
+        {
+            std::string suffix = std::string(", ") + kernelName(kernel);
+            reportBandwidth(type + " add" + suffix, left.size(), 3,
+                            [&] { MatrixKernels::add<T>(left, right, output, kernel); });
+            reportBandwidth(type + " multiply by scalar" + suffix, left.size(), 2,
+                            [&] { MatrixKernels::multiply<T>(left, T(3), output, kernel); });
+            reportBandwidth(type + " divide by scalar" + suffix, left.size(), 2,
+                            [&] { MatrixKernels::divide<T>(left, T(3), output, kernel); });
+        }
+    }
+}
+
+void Benchmark::matrixBenchmark()
+{
+    for (uint32_t dimension : {256u, 2048u})
+    {
+        printHeader("Element-wise matrix arithmetic, " + std::to_string(dimension) + "x" + std::to_string(dimension) +
+                    ", best kernel " + kernelName(MatrixKernels::bestKernel()));
+        Matrix integers(dimension, dimension);
+        Matrix otherIntegers(dimension, dimension);
+        Matrix integerResult(dimension, dimension);
+        kernelRows<int64_t>("integer", integers, otherIntegers, integerResult);
+        Matrix doubles(dimension, dimension, Matrix::ElementType::Double);
+        Matrix otherDoubles(dimension, dimension, Matrix::ElementType::Double);
+        Matrix doubleResult(dimension, dimension, Matrix::ElementType::Double);
+        kernelRows<double>("double", doubles, otherDoubles, doubleResult);
+
+        reportBandwidth("double a + b, new matrix", doubles.size(), 3, [&] { doubleResult = doubles + otherDoubles; });
+        reportBandwidth("double a += b, in place", doubles.size(), 3, [&] { doubles += otherDoubles; });
+        reportBandwidth("double a *= 3, in place", doubles.size(), 2, [&] { doubles *= 3; });
+    }
+}
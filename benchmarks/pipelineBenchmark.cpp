@@ -0,0 +1,81 @@
+#include <thread>
+#include "benchmark.hpp"
+#include "corpusGenerator.hpp"
+#include "lexical_analyzer/tokenPipeline.hpp"
+#include "helpers/hash.hpp"
+
+namespace
+{
+    const size_t CORPUS_SIZE = 16 << 20;
+
+    // Stands in for a parser: a little work per token on top of the lexing.
+    class Consumer
+    {
+    public:
+        explicit Consumer(uint32_t rounds) : rounds(rounds) {}
+
+        void consume(const Token &token)
+        {
+            uint64_t value = static_cast<uint64_t>(token.getType()) ^ token.getAbsolutePosition();
+            if (const std::string *text = std::get_if<std::string>(&token.getValue()))
+                value ^= Hash::xxHash64(*text);
+            for (uint32_t round = 0; round < rounds; ++round)
+                value = Hash::xxHash64(std::string_view(reinterpret_cast<const char *>(&value), sizeof(value)));
+            checksum += value;
+            ++tokenCount;
+        }
+
+        uint64_t getChecksum() const { return checksum; }
+        uint64_t getTokenCount() const { return tokenCount; }
+
+    private:
+        uint32_t rounds;
+        uint64_t checksum = 0;
+        uint64_t tokenCount = 0;
+    };
+
+    template <class Lexer>
+    Consumer drain(Lexer &lexer, uint32_t rounds)
+    {
+        Consumer consumer(rounds);
+        for (;;)
+        {
+            Token token = *lexer.getToken();
+            consumer.consume(token);
+            if (token.getType() == Token::TokenType::EndOfFileToken)
+                return consumer;
+        }
+    }
+}
+
+void Benchmark::pipelineBenchmark()
+{
+    CorpusOptions options;
+    options.size = CORPUS_SIZE;
+    const std::string corpus = CorpusGenerator(options).generate();
+    const double megabytes = corpus.size() / double(1 << 20);
+    printHeader("Lexer and consumer, serial against pipelined, " + std::to_string(corpus.size() >> 20) + " MB, " +
+                std::to_string(std::thread::hardware_concurrency()) + " hardware threads");
+    for (uint32_t rounds : {0u, 4u, 16u})
+    {
+        Consumer serialConsumer(rounds);
+        double serialSeconds = measure([&] {
+            StringSource source(corpus);
+            LexicalAnalyzer lexicalAnalyzer(source, LexicalAnalyzer::CommentMode::Keep,
+                                            LexicalAnalyzer::ErrorMode::Collect);
+            serialConsumer = drain(lexicalAnalyzer, rounds);
+        }, 3);
+        Consumer pipelinedConsumer(rounds);
+        double pipelinedSeconds = measure([&] {
+            StringSource source(corpus);
+            TokenPipeline pipeline(source, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+            pipelinedConsumer = drain(pipeline, rounds);
+        }, 3);
+        if (pipelinedConsumer.getChecksum() != serialConsumer.getChecksum())
+            std::cout << "pipelined tokens differ from serial tokens\n";
+        std::string workload = std::to_string(rounds) + " hash rounds per token";
+        printRow("serial, " + workload, "MB/s", megabytes / serialSeconds);
+        printRow("pipelined, " + workload, "MB/s", megabytes / pipelinedSeconds);
+        printRow("speedup, " + workload, "x", serialSeconds / pipelinedSeconds);
+    }
+}
@@ -0,0 +1,84 @@
+#include <thread>
+#include "benchmark.hpp"
+#include "source.hpp"
+
+namespace
+{
+    const uint PORT = SocketWrapper::DEFAULT_PORT;
+    const size_t MESSAGE_SIZE = 4 << 20;
+
+    std::string buildMessage()
+    {
+        std::string message;
+        message.reserve(MESSAGE_SIZE);
+        while (message.size() < MESSAGE_SIZE)
+            message += "matrix[2][3] matrix1 = [1,2,3,4,5,6]\n";
+        return message;
+    }
+}
+
+void Benchmark::sendOverLoopback(const std::string &message, uint port)
+{
+    sockaddr_in server;
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    for (;;)
+    {
+        int sendSocket = socket(AF_INET, SOCK_STREAM, 0);
+        if (connect(sendSocket, (struct sockaddr *)&server, sizeof server) == 0)
+        {
+            size_t sent = 0;
+            while (sent < message.size())
+            {
+                ssize_t written = write(sendSocket, message.data() + sent, message.size() - sent);
+                if (written <= 0)
+                    break;
+                sent += written;
+            }
+            close(sendSocket);
+            return;
+        }
+        close(sendSocket);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void Benchmark::socketSourceBenchmark()
+{
+    const std::string message = buildMessage();
+    const double kilobytes = message.size() / 1024.0;
+    printHeader("SocketSource over loopback, " + std::to_string(message.size() >> 10) + " KB");
+
+    uint64_t readCalls = 0;
+    double seconds = 0;
+    {
+        std::thread client([&] { sendOverLoopback(message, PORT); });
+        SocketWrapper socketWrapper;
+        socketWrapper.initSocket();
+        seconds = measure([&] {
+            char letter;
+            while (read(socketWrapper.getSocket(), &letter, 1) > 0)
+                ++readCalls;
+            ++readCalls;
+        });
+        client.join();
+        socketWrapper.deinitSocket();
+    }
+    printRow("one byte per read(): syscalls", "per KB", readCalls / kilobytes);
+    printRow("one byte per read(): throughput", "MB/s", kilobytes / 1024 / seconds);
+
+    {
+        std::thread client([&] { sendOverLoopback(message, PORT); });
+        SocketSource source;
+        seconds = measure([&] {
+            source.open();
+            while (source.getChar().nextLetter != '\0')
+                ;
+        });
+        client.join();
+        readCalls = source.getReadCalls();
+    }
+    printRow("buffered SocketSource: syscalls", "per KB", readCalls / kilobytes);
+    printRow("buffered SocketSource: throughput", "MB/s", kilobytes / 1024 / seconds);
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include "benchmark.hpp"
+#include "corpusGenerator.hpp"
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+#include "lexical_analyzer/tokenCache.hpp"
+#include "helpers/hash.hpp"
+
+namespace
+{
+    const size_t CORPUS_SIZE = 32 << 20;
+    const size_t SOCKET_CORPUS_SIZE = 8 << 20;
+    const uint PORT = SocketWrapper::DEFAULT_PORT + 1;
+
+    uint64_t lexAll(SourceBase &source)
+    {
+        LexicalAnalyzer lexicalAnalyzer(source);
+        uint64_t tokenCount = 1;
+        while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+            ++tokenCount;
+        return tokenCount;
+    }
+
+    void report(const std::string &name, size_t bytes, const std::function<uint64_t()> &run)
+    {
+        uint64_t tokenCount = 0;
+        double seconds = Benchmark::measure([&] { tokenCount = run(); }, 3);
+        Benchmark::printRow(name + ": throughput", "MB/s", bytes / double(1 << 20) / seconds);
+        Benchmark::printRow(name + ": tokens", "Mtokens/s", tokenCount / seconds / 1e6);
+    }
+
+    template <class Source>
+    void reportFile(const std::string &name, const std::string &path, size_t bytes)
+    {
+        report(name, bytes, [&] {
+            Source source(path);
+            return lexAll(source);
+        });
+    }
+
+    void tokenCacheBenchmark(const std::string &path)
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "tkomTokenCacheBenchmark";
+        MappedFileSource source(path);
+        source.open();
+        Benchmark::printHeader("Token cache over MappedFileSource, " + std::to_string(source.getSizeHint() >> 20) + " MB");
+        uint64_t sourceHash = 0;
+        double seconds = Benchmark::measure([&] { sourceHash = Hash::xxHash64(source.getBuffer()); }, 3);
+        Benchmark::printRow("xxHash64 of source", "ms", seconds * 1e3);
+        seconds = Benchmark::measure([&] {
+            MappedFileSource lexedSource(path);
+            LexicalAnalyzer lexicalAnalyzer(lexedSource);
+            lexicalAnalyzer.tokenizeAll();
+        }, 3);
+        Benchmark::printRow("tokenizeAll without cache", "ms", seconds * 1e3);
+        seconds = Benchmark::measure([&] {
+            std::filesystem::remove_all(directory);
+            TokenCache(directory).tokenize(source.getBuffer());
+        }, 3);
+        Benchmark::printRow("cache miss: lex and store", "ms", seconds * 1e3);
+        size_t tokenCount = 0;
+        seconds = Benchmark::measure([&] {
+            MappedFileSource cachedSource(path);
+            cachedSource.open();
+            tokenCount = TokenCache(directory).tokenize(cachedSource.getBuffer())->size();
+        }, 3);
+        Benchmark::printRow("cache hit: hash and map", "ms", seconds * 1e3);
+        Benchmark::printRow("cached tokens", "tokens", tokenCount);
+        std::filesystem::remove_all(directory);
+    }
+}
+
+void Benchmark::sourceLexingBenchmark()
+{
+    CorpusOptions options;
+    options.size = CORPUS_SIZE;
+    const std::string corpus = CorpusGenerator(options).generate();
+    const std::string path = std::filesystem::temp_directory_path() / "tkomCorpusBenchmark.mpp";
+    std::ofstream(path) << corpus;
+
+    printHeader("Lexing generated corpus per source, " + std::to_string(corpus.size() >> 20) + " MB");
+    {
+        StringSource source(corpus);
+        LexicalAnalyzer lexicalAnalyzer(source, LexicalAnalyzer::CommentMode::Keep,
+                                        LexicalAnalyzer::ErrorMode::Collect);
+        uint64_t tokenCount = 1;
+        while (lexicalAnalyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+            ++tokenCount;
+        printRow("corpus tokens", "tokens", tokenCount);
+        printRow("corpus lexical errors", "errors", lexicalAnalyzer.getDiagnostics().size());
+    }
+    report("StringSource", corpus.size(), [&] {
+        StringSource source(corpus);
+        return lexAll(source);
+    });
+    reportFile<FileSource>("FileSource", path, corpus.size());
+    reportFile<MappedFileSource>("MappedFileSource", path, corpus.size());
+    reportFile<ReadAheadFileSource>("ReadAheadFileSource", path, corpus.size());
+    for (uint32_t threadCount : {1u, 2u, 4u, 8u})
+    {
+        TokenStream stream;
+        report("MappedFileSource, " + std::to_string(threadCount) + " threads", corpus.size(), [&] {
+            MappedFileSource source(path);
+            LexicalAnalyzer lexicalAnalyzer(source);
+            lexicalAnalyzer.tokenizeAllParallel(stream, threadCount);
+            return stream.size();
+        });
+    }
+    tokenCacheBenchmark(path);
+    std::remove(path.c_str());
+
+    options.size = SOCKET_CORPUS_SIZE;
+    const std::string socketCorpus = CorpusGenerator(options).generate();
+    report("SocketSource over loopback, " + std::to_string(socketCorpus.size() >> 20) + " MB",
+           socketCorpus.size(), [&] {
+               std::thread client([&] { sendOverLoopback(socketCorpus, PORT); });
+               SocketSource source(PORT);
+               uint64_t tokenCount = lexAll(source);
+               client.join();
+               return tokenCount;
+           });
+}
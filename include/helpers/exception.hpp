@@ -33,6 +33,11 @@ public:
     WrongFilepathException(const char *m) : Exception(m) {}
 };
 
+class CannotReadSourceException : public Exception {
+public:
+    CannotReadSourceException(const char *m) : Exception(m) {}
+};
+
 class CannotCreateSourceException : public Exception {
 public:
     CannotCreateSourceException(const char *m) : Exception(m) {}
@@ -61,4 +66,59 @@ public:
 class IntegerTooBig : public Exception {
 public:
     IntegerTooBig(const char *m) : Exception(m) {}
-};
\ No newline at end of file
+};
+
+class SourceTooLargeException : public Exception {
+public:
+    SourceTooLargeException(const char *m) : Exception(m) {}
+};
+
+class InvalidSourceEdit : public Exception {
+public:
+    InvalidSourceEdit(const char *m) : Exception(m) {}
+};
+
+class TokenCacheException : public Exception {
+public:
+    TokenCacheException(const char *m) : Exception(m) {}
+};
+
+class TokenStreamException : public Exception {
+public:
+    TokenStreamException(const char *m) : Exception(m) {}
+};
+
+class LookaheadOutOfRange : public Exception {
+public:
+    LookaheadOutOfRange(const char *m) : Exception(m) {}
+};
+
+class FeedClosedException : public Exception {
+public:
+    FeedClosedException(const char *m) : Exception(m) {}
+};
+
+class MatrixDimensionMismatch : public Exception {
+public:
+    MatrixDimensionMismatch(const char *m) : Exception(m) {}
+};
+
+class MatrixIndexOutOfRange : public Exception {
+public:
+    MatrixIndexOutOfRange(const char *m) : Exception(m) {}
+};
+
+class MatrixTypeMismatch : public Exception {
+public:
+    MatrixTypeMismatch(const char *m) : Exception(m) {}
+};
+
+class MatrixDivisionByZero : public Exception {
+public:
+    MatrixDivisionByZero(const char *m) : Exception(m) {}
+};
+
+class MatrixTooLarge : public Exception {
+public:
+    MatrixTooLarge(const char *m) : Exception(m) {}
+};
@@ -6,7 +6,13 @@ namespace FlagResolver
     enum class Options
     {
         File,
+        MappedFile,
+        StreamedFile,
+        CachedFile,
+        Statistics,
+        Pipeline,
         Socket,
+        Server,
         String,
         Help,
         Null
@@ -17,8 +23,20 @@ namespace FlagResolver
             return Options::Help;
         else if (option == "--file" || option == "--f")
             return Options::File;
+        else if (option == "--mmap" || option == "--m")
+            return Options::MappedFile;
+        else if (option == "--stream" || option == "--st")
+            return Options::StreamedFile;
+        else if (option == "--cache" || option == "--c")
+            return Options::CachedFile;
+        else if (option == "--stats" || option == "--sts")
+            return Options::Statistics;
+        else if (option == "--pipeline" || option == "--p")
+            return Options::Pipeline;
         else if (option == "--socket" || option == "--sc")
             return Options::Socket;
+        else if (option == "--server" || option == "--sv")
+            return Options::Server;
         else if (option == "--string" || option == "--s")
             return Options::String;
         return Options::Null;
@@ -0,0 +1,8 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace Hash
+{
+    uint64_t xxHash64(std::string_view data, uint64_t seed = 0);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+#ifdef TKOM_INSTRUMENTATION
+#define INSTRUMENT(statement) statement
+#define INSTRUMENT_PHASE(statistics, phase, expression) (statistics).record((phase), [&] { return (expression); })
+#else
+#define INSTRUMENT(statement)
+#define INSTRUMENT_PHASE(statistics, phase, expression) (expression)
+#endif
+
+namespace Instrumentation
+{
+    inline uint64_t readCycleCounter()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    struct SourceStatistics
+    {
+        uint64_t refills = 0;
+        uint64_t systemCalls = 0;
+    };
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+#include <string>
+#include "position.hpp"
+
+class LineIndex
+{
+public:
+    LineIndex() : lineStarts{0} {}
+    void addLineStart(uint64_t absolutePosition)
+    {
+        if (absolutePosition > lineStarts.back())
+            lineStarts.push_back(absolutePosition);
+    }
+    void clear() { lineStarts.assign(1, 0); }
+    Position resolve(uint64_t absolutePosition) const;
+    std::string describe(uint64_t absolutePosition) const;
+    uint64_t getLineCount() const { return lineStarts.size(); }
+
+private:
+    std::vector<uint64_t> lineStarts;
+};
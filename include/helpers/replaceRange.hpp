@@ -0,0 +1,16 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+namespace Containers
+{
+    template <class T>
+    void replaceRange(std::vector<T> &target, size_t first, size_t last, const std::vector<T> &replacement)
+    {
+        size_t common = std::min(last - first, replacement.size());
+        std::copy_n(replacement.begin(), common, target.begin() + first);
+        if (common < replacement.size())
+            target.insert(target.begin() + last, replacement.begin() + common, replacement.end());
+        else
+            target.erase(target.begin() + first + common, target.begin() + last);
+    }
+}
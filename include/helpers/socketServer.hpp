@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "socketWrapper.hpp"
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+
+// Each connection is read until the client shuts down its sending side, then
+// lexed on a worker by its own source and LexicalAnalyzer. Programs longer than
+// maxProgramSize are discarded as they arrive and answered with an error.
+class SocketServer
+{
+public:
+    using Handler = std::function<std::string(LexicalAnalyzer &)>;
+
+    static constexpr size_t DEFAULT_MAX_PROGRAM_SIZE = 64 << 20;
+
+    SocketServer(uint port, uint workerCount, Handler handler, size_t maxProgramSize = DEFAULT_MAX_PROGRAM_SIZE);
+    ~SocketServer();
+    void run();
+    void stop();
+    uint getPort() const { return port; }
+    uint getWorkerCount() const { return workers.size(); }
+
+private:
+    struct PendingProgram
+    {
+        std::string program;
+        bool tooLarge = false;
+    };
+
+    struct Job
+    {
+        int connection;
+        std::string program;
+        bool tooLarge = false;
+    };
+
+    void acceptConnections();
+    void registerConnection(int connection);
+    void pauseAccepting();
+    void resumeAccepting();
+    void receive(int connection);
+    void dispatch(int connection);
+    void dropConnection(int connection);
+    void workerLoop();
+    void release();
+    void respond(Job &job);
+
+    static const int MAX_EVENTS = 128;
+    static const size_t RECEIVE_SIZE = 1 << 16;
+    static constexpr std::chrono::milliseconds ACCEPT_BACKOFF{100};
+    uint port;
+    Handler handler;
+    size_t maxProgramSize;
+    int listeningSocket = -1;
+    int epollDescriptor = -1;
+    int stopDescriptor = -1;
+    std::atomic<bool> stopping;
+    bool acceptPaused = false;
+    std::chrono::steady_clock::time_point acceptResumeTime;
+    std::unordered_map<int, PendingProgram> pendingPrograms;
+    std::vector<std::thread> workers;
+    std::queue<Job> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsCondition;
+};
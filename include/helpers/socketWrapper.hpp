@@ -12,18 +12,36 @@
 class SocketWrapper
 {
 public:
-    void initSocket()
+    static const uint DEFAULT_PORT = 35555;
+    SocketWrapper(uint port = DEFAULT_PORT) : PORT(port) {}
+
+    static int openListeningSocket(uint port, int backlog)
     {
         int serverSocket = socket(AF_INET, SOCK_STREAM, 0);
         if (serverSocket == -1)
             throw SocketProblemException("Cannot open socket!");
+        int reuse = 1;
+        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
         sockaddr_in server;
         server.sin_family = AF_INET;
         server.sin_addr.s_addr = INADDR_ANY;
-        server.sin_port = htons(PORT);
+        server.sin_port = htons(port);
         if (bind(serverSocket, (struct sockaddr *)&server, sizeof server) == -1)
+        {
+            close(serverSocket);
             throw SocketProblemException("Cannot bind socket!");
-        listen(serverSocket, 5);
+        }
+        if (listen(serverSocket, backlog) == -1)
+        {
+            close(serverSocket);
+            throw SocketProblemException("Cannot listen on socket!");
+        }
+        return serverSocket;
+    }
+
+    void initSocket()
+    {
+        int serverSocket = openListeningSocket(PORT, 5);
         int messageSocket = accept(serverSocket, nullptr, nullptr);
         if (messageSocket == -1)
             throw SocketProblemException("Cannot accept incoming connection!");
@@ -41,7 +59,7 @@ public:
     uint getSocket() const {return receiveSocket;}
 
 private:
-    const uint PORT = 35555;
+    const uint PORT;
     uint receiveSocket;
 };
 
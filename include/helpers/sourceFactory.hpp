@@ -6,5 +6,6 @@
 #include "flagResolver.hpp"
 
 namespace SourceFactory{
+    const uintmax_t MAPPED_FILE_THRESHOLD = 1 << 20;
     SourceUptr createSource(const FlagResolver::Options option, const std::vector<std::string_view>& arguments);
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+namespace Containers
+{
+    // Bounded queue for exactly one producer thread and one consumer thread.
+    template <class T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of two");
+
+    public:
+        bool tryPush(T &value)
+        {
+            uint64_t position = tail.load(std::memory_order_relaxed);
+            if (position - cachedHead == Capacity)
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (position - cachedHead == Capacity)
+                    return false;
+            }
+            slots[position & MASK] = std::move(value);
+            tail.store(position + 1, std::memory_order_release);
+            tail.notify_one();
+            return true;
+        }
+
+        bool tryPop(T &value)
+        {
+            uint64_t position = head.load(std::memory_order_relaxed);
+            if (position == cachedTail)
+            {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (position == cachedTail)
+                    return false;
+            }
+            value = std::move(slots[position & MASK]);
+            head.store(position + 1, std::memory_order_release);
+            head.notify_one();
+            return true;
+        }
+
+        void waitWhileFull() const { head.wait(tail.load(std::memory_order_relaxed) - Capacity, std::memory_order_acquire); }
+        void waitWhileEmpty() const { tail.wait(head.load(std::memory_order_relaxed), std::memory_order_acquire); }
+        static constexpr size_t getCapacity() { return Capacity; }
+
+    private:
+        static const uint64_t MASK = Capacity - 1;
+        alignas(64) std::atomic<uint64_t> head{0};
+        uint64_t cachedTail = 0;
+        alignas(64) std::atomic<uint64_t> tail{0};
+        uint64_t cachedHead = 0;
+        alignas(64) std::array<T, Capacity> slots;
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include "token.hpp"
+
+struct CompactToken
+{
+    enum class PayloadKind : uint8_t
+    {
+        None,
+        Integer,
+        Double,
+        Symbol,
+        Text,
+        Matrix,
+    };
+
+    Token::TokenType type;
+    Token::TokenSubtype subtype;
+    PayloadKind payloadKind;
+    uint8_t reserved;
+    uint32_t absolutePosition;
+    union
+    {
+        int64_t integer;
+        double floating;
+        uint64_t index;
+    };
+
+    // The payload as raw bits, read and written through the member that payloadKind makes active.
+    uint64_t getPayloadBits() const
+    {
+        switch (payloadKind)
+        {
+        case PayloadKind::None:
+            return 0;
+        case PayloadKind::Integer:
+            return std::bit_cast<uint64_t>(integer);
+        case PayloadKind::Double:
+            return std::bit_cast<uint64_t>(floating);
+        default:
+            return index;
+        }
+    }
+
+    void setPayloadBits(uint64_t bits)
+    {
+        switch (payloadKind)
+        {
+        case PayloadKind::Integer:
+            integer = std::bit_cast<int64_t>(bits);
+            break;
+        case PayloadKind::Double:
+            floating = std::bit_cast<double>(bits);
+            break;
+        default:
+            index = bits;
+        }
+    }
+};
+
+static_assert(sizeof(CompactToken) == 16);
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+struct Diagnostic
+{
+    enum class Kind : uint8_t
+    {
+        CommentTooLong,
+        StringLiteralTooLong,
+        MalformedStringLiteral,
+        MalformedExponent,
+        MalformedHexLiteral,
+        IntegerTooBig,
+        DoubleOutOfRange,
+        InconsistentIndentCharacters,
+        InconsistentIndent,
+    };
+
+    Kind kind;
+    uint64_t absolutePosition;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "lexicalAnalyzer.hpp"
+
+class IncrementalLexer
+{
+public:
+    IncrementalLexer(std::string text, LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep);
+    void edit(uint64_t offset, uint64_t removedLength, std::string_view insertedText);
+    Token expand(size_t index) const;
+    Position resolvePosition(uint64_t absolutePosition) const;
+    const std::string& getText() const { return text; }
+    const TokenStream& getTokens() const { return stream; }
+    const SymbolTable& getSymbolTable() const { return tables->symbolTable; }
+    const std::vector<Diagnostic>& getDiagnostics() const { return diagnostics; }
+    size_t getRelexedTokenCount() const { return relexedTokenCount; }
+
+private:
+    struct Line
+    {
+        uint32_t start;
+        uint32_t indentState;
+    };
+
+    struct IndentState
+    {
+        std::stack<std::string> indentStack;
+        char chosenIndentChar;
+    };
+
+    void relex(size_t firstLine, uint64_t editEnd, int64_t delta);
+    uint32_t captureIndentState(const LexicalAnalyzer& analyzer, uint32_t previous);
+    bool sameIndentState(uint32_t first, uint32_t second) const;
+    void compactIndentStates();
+    void compactSymbols();
+    uint32_t remapSymbol(const LexicalAnalyzer& analyzer, uint64_t id, std::vector<uint32_t>& symbols);
+    std::string text;
+    LexicalAnalyzer::CommentMode commentMode;
+    TokenStream stream;
+    std::shared_ptr<TokenTables> tables = std::make_shared<TokenTables>();
+    std::vector<Diagnostic> diagnostics;
+    std::vector<Line> lines;
+    std::vector<IndentState> indentStates;
+    size_t relexedTokenCount = 0;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include "compactToken.hpp"
+#include "helpers/instrumentation.hpp"
+
+class LexerStatistics
+{
+public:
+    enum class Phase : uint8_t
+    {
+        Indentation,
+        Whitespace,
+        Identifiers,
+        Numbers,
+        Strings,
+        Comments,
+        Operators,
+        Other,
+    };
+
+    template <class Build>
+    auto record(Phase phase, Build build)
+    {
+        uint64_t start = Instrumentation::readCycleCounter();
+        if constexpr (std::is_void_v<std::invoke_result_t<Build>>)
+        {
+            build();
+            phaseCycles[static_cast<size_t>(phase)] += Instrumentation::readCycleCounter() - start;
+        }
+        else
+        {
+            auto token = build();
+            phaseCycles[static_cast<size_t>(phase)] += Instrumentation::readCycleCounter() - start;
+            countToken(token);
+            return token;
+        }
+    }
+    void countToken(const Token &token) { ++tokenCounts[static_cast<size_t>(token.getType())]; }
+    void countToken(const std::optional<Token> &token)
+    {
+        if (token)
+            countToken(*token);
+    }
+    void countToken(const CompactToken &token) { ++tokenCounts[static_cast<size_t>(token.type)]; }
+    void countToken(const std::optional<CompactToken> &token)
+    {
+        if (token)
+            countToken(*token);
+    }
+    void recordIndentDepth(uint64_t depth) { maxIndentDepth = std::max(maxIndentDepth, depth); }
+    void setSourceStatistics(uint64_t bytes, const Instrumentation::SourceStatistics &source)
+    {
+        bytesConsumed = bytes;
+        sourceStatistics = source;
+    }
+    uint64_t getTokenCount(Token::TokenType type) const { return tokenCounts[static_cast<size_t>(type)]; }
+    uint64_t getTokenCount() const;
+    uint64_t getPhaseCycles(Phase phase) const { return phaseCycles[static_cast<size_t>(phase)]; }
+    uint64_t getBytesConsumed() const { return bytesConsumed; }
+    uint64_t getMaxIndentDepth() const { return maxIndentDepth; }
+    const Instrumentation::SourceStatistics &getSourceStatistics() const { return sourceStatistics; }
+    std::string toText() const;
+    std::string toJson() const;
+    static const char *getName(Token::TokenType type);
+    static const char *getName(Phase phase);
+    static const size_t TOKEN_TYPE_COUNT = static_cast<size_t>(Token::TokenType::ErrorToken) + 1;
+    static const size_t PHASE_COUNT = static_cast<size_t>(Phase::Other) + 1;
+
+private:
+    std::array<uint64_t, TOKEN_TYPE_COUNT> tokenCounts{};
+    std::array<uint64_t, PHASE_COUNT> phaseCycles{};
+    uint64_t bytesConsumed = 0;
+    uint64_t maxIndentDepth = 0;
+    Instrumentation::SourceStatistics sourceStatistics;
+};
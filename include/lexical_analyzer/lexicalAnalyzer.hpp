@@ -2,49 +2,123 @@
 #include <map>
 #include <stack>
 #include <optional>
-#include <cmath>
 #include <limits>
+#include <charconv>
+#include <atomic>
+#include <thread>
 #include "token.hpp"
+#include "compactToken.hpp"
+#include "tokenStream.hpp"
 #include "source.hpp"
 #include "lexicalTable.hpp"
+#include "symbolTable.hpp"
+#include "scanner.hpp"
+#include "diagnostic.hpp"
+#include "lexerStatistics.hpp"
 #include "helpers/operators.hpp"
 class LexicalAnalyzer
 {
+    friend class IncrementalLexer;
+
 public:
-    LexicalAnalyzer(SourceBase& source) : source(source), isNextLine(true), chosenIndentChar(0)
+    enum class CommentMode : uint8_t
+    {
+        Keep,
+        Discard,
+    };
+
+    enum class ErrorMode : uint8_t
+    {
+        Throw,
+        Collect,
+    };
+
+    LexicalAnalyzer(SourceBase& source, CommentMode commentMode = CommentMode::Keep,
+                    ErrorMode errorMode = ErrorMode::Throw)
+        : source(source), commentMode(commentMode), errorMode(errorMode), isNextLine(true), chosenIndentChar(0)
     {
         source.open();
+        buffer = source.getBuffer();
         indentStack.push("");
     };
     void setSource(SourceBase& source)
     {
         this->source = source;
         source.open();
+        buffer = source.getBuffer();
     }
     std::optional<Token> getToken();
+    std::optional<CompactToken> getCompactToken();
+    Token expand(const CompactToken& token) const;
+    TokenStream tokenizeAll();
+    void tokenizeAll(TokenStream& stream);
+    void tokenizeAllParallel(TokenStream& stream, uint32_t threadCount = std::thread::hardware_concurrency(),
+                             size_t chunkSize = PARALLEL_CHUNK_SIZE);
+    static const size_t PARALLEL_CHUNK_SIZE = 1 << 20;
+    static const uint32_t VERSION = 2;
+    const SymbolTable& getSymbolTable() const { return tables->symbolTable; }
+    const std::vector<Diagnostic>& getDiagnostics() const { return diagnostics; }
+    std::string describe(const Diagnostic& diagnostic) const;
+#ifdef TKOM_INSTRUMENTATION
+    LexerStatistics getStatistics() const;
+#endif
 
 
 private:
+    enum class IndentChange : uint8_t
+    {
+        None,
+        Open,
+        Close,
+        InconsistentCharacters,
+        Inconsistent,
+    };
+
+    struct IndentMarker
+    {
+        uint64_t absolutePosition;
+        uint32_t length;
+        char letter;
+    };
+
+    std::optional<CompactToken> lexToken();
     void skipWhites();
-    std::optional<Token> buildNumber();
-    int64_t buildInteger(NextCharacter& current);
-    double buildFloatingPointNumber(NextCharacter& current, int64_t integerPart);
-    bool checkIfFits(const std::string_view limit,
-                                const std::string_view numberToCheck) const;
-    std::optional<Token> buildIdentifierOrKeyword();
-    std::optional<Token> buildDivisionTokenOrComment();
-    std::optional<Token> buildStringLiteral();
-    std::optional<Token> buildComment();
-    std::optional<Token> buildIndent();
-    std::optional<Token> buildUnindentified();
-    std::optional<Token> buildLogicalOperatorToken();
-    std::optional<Token> buildEOF();
-    std::optional<Token> buildOneCharToken();
-    std::optional<Token> buildIndentToken();
+    CompactToken buildNumber(NextCharacter& current);
+    CompactToken buildHexInteger(NextCharacter& current);
+    NextCharacter appendDigits(NextCharacter nextCharacter);
+    CompactToken buildIdentifierOrKeyword(NextCharacter& current);
+    std::optional<CompactToken> buildDivisionTokenOrComment(NextCharacter& current);
+    CompactToken buildStringLiteral(NextCharacter& current);
+    CompactToken buildComment(NextCharacter& current);
+    void skipComment(NextCharacter& current);
+    std::optional<CompactToken> buildIndent(NextCharacter& current);
+    IndentChange changeIndent(char letter, uint32_t length);
+    void stitchChunk(const LexicalAnalyzer& chunkAnalyzer, const TokenStream& chunkStream,
+                     uint64_t offset, bool isLast, TokenStream& stream);
+    CompactToken buildUnindentified(NextCharacter& current);
+    CompactToken buildLogicalOperatorToken(NextCharacter& current);
+    CompactToken buildEOF(NextCharacter& current);
+    CompactToken buildOneCharToken(NextCharacter& current);
+    uint32_t compactPosition(uint64_t absolutePosition) const;
+    Token expand(const CompactToken& token, uint64_t absolutePosition) const;
+    CompactToken reportError(Diagnostic::Kind kind, NextCharacter& current);
+    [[noreturn]] void throwError(const Diagnostic& diagnostic) const;
     SourceBase& source;
+    std::string_view buffer;
+    CommentMode commentMode;
+    ErrorMode errorMode;
+    std::vector<Diagnostic> diagnostics;
     bool isNextLine;
     char chosenIndentChar;
     std::stack<std::string> indentStack;
+    bool deferIndentation = false;
+    std::vector<IndentMarker> indentMarkers;
+    std::string lexeme;
+    uint64_t tokenPosition = 0;
+    std::shared_ptr<TokenTables> tables = std::make_shared<TokenTables>();
+#ifdef TKOM_INSTRUMENTATION
+    LexerStatistics statistics;
+#endif
     const uint32_t MAXSIZE = 2048;
 };
 
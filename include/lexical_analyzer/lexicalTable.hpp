@@ -1,32 +1,140 @@
 #pragma once
-#include <map>
+#include <array>
+#include <optional>
+#include <string_view>
 #include "token.hpp"
 
 namespace LexicalTable{
-const static std::map<std::string, Token::TokenType> keywordTable = {
-    {"matrix", Token::TokenType::MatrixToken},
-    {"text", Token::TokenType::TextToken}, 
-    {"double",Token::TokenType::DoubleToken}, 
-    {"integer",Token::TokenType::IntegerToken}, 
-    {"function",Token::TokenType::FunctionToken}, 
-    {"void",Token::TokenType::VoidToken}, 
-    {"condition",Token::TokenType::ConditionToken}, 
-    {"case",Token::TokenType::CaseToken}, 
-    {"if",Token::TokenType::IfToken}, 
-    {"otherwise",Token::TokenType::OtherwiseToken}, 
-    {"loop",Token::TokenType::LoopToken}, 
-    {"asLongAs",Token::TokenType::AsLongAsToken}, 
-    {"continue",Token::TokenType::ContinueToken}, 
-    {"break",Token::TokenType::BreakToken}, 
-    {"default",Token::TokenType::DefaultToken}, 
-    {"true",Token::TokenType::TrueToken}, 
-    {"false",Token::TokenType::FalseToken}, 
-    {"and",Token::TokenType::AndToken}, 
-    {"or",Token::TokenType::OrToken}, 
-    {"not",Token::TokenType::NotToken}, 
-    {"det",Token::TokenType::DetToken}, 
-    {"trans",Token::TokenType::TransToken}, 
-    {"inv",Token::TokenType::InvToken}, 
-    {"return",Token::TokenType::ReturnToken} 
+enum class CharacterClass : uint8_t
+{
+    Other,
+    EndOfFile,
+    Space,
+    NewLine,
+    Letter,
+    Digit,
+    Quote,
+    Hash,
+    Slash,
+    Operator,
+    Relational,
+};
+
+constexpr std::array<CharacterClass, 256> buildCharacterClasses()
+{
+    std::array<CharacterClass, 256> classes{};
+    classes['\0'] = CharacterClass::EndOfFile;
+    for (unsigned char letter : {' ', '\t', '\r', '\v', '\f'})
+        classes[letter] = CharacterClass::Space;
+    classes['\n'] = CharacterClass::NewLine;
+    for (unsigned char letter = 'a'; letter <= 'z'; ++letter)
+        classes[letter] = CharacterClass::Letter;
+    for (unsigned char letter = 'A'; letter <= 'Z'; ++letter)
+        classes[letter] = CharacterClass::Letter;
+    for (unsigned char letter = '0'; letter <= '9'; ++letter)
+        classes[letter] = CharacterClass::Digit;
+    classes['\''] = classes['"'] = CharacterClass::Quote;
+    classes['#'] = CharacterClass::Hash;
+    classes['/'] = CharacterClass::Slash;
+    for (unsigned char letter : {'+', '-', '*', '(', ')', '[', ']', ':', '.', ','})
+        classes[letter] = CharacterClass::Operator;
+    for (unsigned char letter : {'<', '>', '=', '!'})
+        classes[letter] = CharacterClass::Relational;
+    return classes;
+}
+
+constexpr std::array<CharacterClass, 256> characterClasses = buildCharacterClasses();
+
+constexpr CharacterClass classify(char letter)
+{
+    return characterClasses[static_cast<unsigned char>(letter)];
+}
+
+constexpr bool isIdentifierCharacter(char letter)
+{
+    CharacterClass characterClass = classify(letter);
+    return characterClass == CharacterClass::Letter || characterClass == CharacterClass::Digit || letter == '_';
+}
+
+constexpr bool isDigit(char letter)
+{
+    return classify(letter) == CharacterClass::Digit;
+}
+
+constexpr int hexDigitValue(char letter)
+{
+    if (letter >= '0' && letter <= '9')
+        return letter - '0';
+    if (letter >= 'a' && letter <= 'f')
+        return letter - 'a' + 10;
+    if (letter >= 'A' && letter <= 'F')
+        return letter - 'A' + 10;
+    return -1;
+}
+
+struct KeywordEntry
+{
+    std::string_view word;
+    Token::TokenType type;
 };
+
+constexpr std::array<KeywordEntry, 24> keywords = {{
+    {"matrix", Token::TokenType::MatrixToken},
+    {"text", Token::TokenType::TextToken},
+    {"double", Token::TokenType::DoubleToken},
+    {"integer", Token::TokenType::IntegerToken},
+    {"function", Token::TokenType::FunctionToken},
+    {"void", Token::TokenType::VoidToken},
+    {"condition", Token::TokenType::ConditionToken},
+    {"case", Token::TokenType::CaseToken},
+    {"if", Token::TokenType::IfToken},
+    {"otherwise", Token::TokenType::OtherwiseToken},
+    {"loop", Token::TokenType::LoopToken},
+    {"asLongAs", Token::TokenType::AsLongAsToken},
+    {"continue", Token::TokenType::ContinueToken},
+    {"break", Token::TokenType::BreakToken},
+    {"default", Token::TokenType::DefaultToken},
+    {"true", Token::TokenType::TrueToken},
+    {"false", Token::TokenType::FalseToken},
+    {"and", Token::TokenType::AndToken},
+    {"or", Token::TokenType::OrToken},
+    {"not", Token::TokenType::NotToken},
+    {"det", Token::TokenType::DetToken},
+    {"trans", Token::TokenType::TransToken},
+    {"inv", Token::TokenType::InvToken},
+    {"return", Token::TokenType::ReturnToken},
+}};
+
+constexpr size_t KEYWORD_TABLE_SIZE = 64;
+
+constexpr size_t hashKeyword(const std::string_view word)
+{
+    return (word.size() * 4 + static_cast<unsigned char>(word.front()) +
+            static_cast<unsigned char>(word.back()) * 40) % KEYWORD_TABLE_SIZE;
+}
+
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> buildKeywordTable()
+{
+    std::array<KeywordEntry, KEYWORD_TABLE_SIZE> table{};
+    for (const KeywordEntry &keyword : keywords)
+    {
+        KeywordEntry &slot = table[hashKeyword(keyword.word)];
+        if (!slot.word.empty())
+            throw "Keyword hash is not perfect";
+        slot = keyword;
+    }
+    return table;
+}
+
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> keywordTable = buildKeywordTable();
+
+constexpr std::optional<Token::TokenType> findKeyword(const std::string_view word)
+{
+    if (word.empty())
+        return {};
+    const KeywordEntry &entry = keywordTable[hashKeyword(word)];
+    if (entry.word == word)
+        return entry.type;
+    return {};
+}
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Scanner
+{
+    enum class Kernel : uint8_t
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    Kernel bestKernel();
+    size_t findNonSpace(std::string_view text, size_t from, Kernel kernel = bestKernel());
+    size_t findLineEnd(std::string_view text, size_t from, Kernel kernel = bestKernel());
+    size_t findStringEnd(std::string_view text, size_t from, char delimiter, Kernel kernel = bestKernel());
+}
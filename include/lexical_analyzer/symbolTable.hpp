@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct Symbol
+{
+    uint32_t id;
+    std::string_view text;
+
+    // Ids are only unique within one table, so symbols from different tables are compared by text.
+    friend bool operator==(Symbol const &lhs, Symbol const &rhs)
+    {
+        return lhs.text == rhs.text;
+    };
+};
+
+class SymbolTable
+{
+public:
+    SymbolTable() : slots(INITIAL_SLOTS, EMPTY_SLOT) {}
+    Symbol intern(const std::string_view text);
+    Symbol internView(const std::string_view text);
+    std::string_view getText(uint32_t id) const { return symbols[id]; }
+    size_t size() const { return symbols.size(); }
+
+private:
+    uint32_t &findSlot(const std::string_view text);
+    Symbol insert(uint32_t &slot, const std::string_view text);
+    void grow();
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+    static constexpr size_t INITIAL_SLOTS = 1024;
+    std::deque<std::string> storage;
+    std::vector<std::string_view> symbols;
+    std::vector<uint32_t> slots;
+};
@@ -4,13 +4,14 @@
 #include <string>
 #include "matrix.hpp"
 #include "source.hpp"
+#include "symbolTable.hpp"
 
 using TokenVariant = std::variant<std::monostate, int64_t, double, std::string, Matrix>;
 
 class Token
 {
 public:
-    enum class TokenType
+    enum class TokenType : uint8_t
     {
         MatrixToken,
         IntegerToken,
@@ -58,9 +59,10 @@ public:
         TransToken,
         InvToken,
         ReturnToken,
+        ErrorToken,
     };
 
-    enum class TokenSubtype
+    enum class TokenSubtype : uint8_t
     {
         PlusToken,
         MinusToken,
@@ -72,34 +74,38 @@ public:
         NotEqualToken,
         DivisionToken,
         MultiplicationToken,
+        NoSubtype,
     };
 
     Token(TokenType type, TokenVariant value,
          NextCharacter& firstCharacter)
-        : type(type), value(value),
-        characterPosition(firstCharacter.characterPosition),
-        absolutePosition(firstCharacter.absolutePosition), linePosition(firstCharacter.linePosition) {}
+        : type(type), subtype(TokenSubtype::NoSubtype), value(std::move(value)),
+        absolutePosition(firstCharacter.absolutePosition) {}
     Token(TokenType type, TokenSubtype subtype, TokenVariant value,
         NextCharacter& firstCharacter)
-        : type(type), subtype(subtype), value(value),
-        characterPosition(firstCharacter.characterPosition),
-        absolutePosition(firstCharacter.absolutePosition), linePosition(firstCharacter.linePosition) {}
-    Token(TokenType type) : type(type) {}
-    Token(TokenType type, TokenVariant value) : type(type), value(value) {}
+        : type(type), subtype(subtype), value(std::move(value)), absolutePosition(firstCharacter.absolutePosition) {}
+    Token(TokenType type, TokenSubtype subtype, TokenVariant value, uint64_t absolutePosition)
+        : type(type), subtype(subtype), value(std::move(value)), absolutePosition(absolutePosition) {}
+    Token(TokenType type, TokenSubtype subtype, Symbol symbol, uint64_t absolutePosition)
+        : type(type), subtype(subtype), symbolId(symbol.id), value(std::string(symbol.text)),
+        absolutePosition(absolutePosition) {}
+    Token(TokenType type) : type(type), subtype(TokenSubtype::NoSubtype), absolutePosition(0) {}
+    Token(TokenType type, TokenVariant value) : type(type), subtype(TokenSubtype::NoSubtype),
+        value(std::move(value)), absolutePosition(0) {}
+    static constexpr uint32_t NO_SYMBOL = UINT32_MAX;
     TokenType getType() const { return type; }
     TokenSubtype getSubtype() const { return subtype; }
-    TokenVariant getValue() const{return value;}
-    uint64_t getCharacterPosition() const { return characterPosition; }
+    const TokenVariant& getValue() const{return value;}
+    // Id of the identifier, comment or string literal in the symbol table of the analyzer that produced it.
+    uint32_t getSymbolId() const { return symbolId; }
     uint64_t getAbsolutePosition() const { return absolutePosition; }
-    uint64_t getLinePosition() const { return linePosition; }
 
 private:
     TokenType type;
     TokenSubtype subtype;
+    uint32_t symbolId = NO_SYMBOL;
     TokenVariant value;
-    uint64_t characterPosition;
     uint64_t absolutePosition;
-    uint64_t linePosition;
 
     friend bool operator==(Token const &lhs, Token const &rhs)
     {
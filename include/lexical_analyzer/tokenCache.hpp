@@ -0,0 +1,63 @@
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include "lexicalAnalyzer.hpp"
+
+class CachedTokenStream
+{
+public:
+    CachedTokenStream(const CachedTokenStream &) = delete;
+    CachedTokenStream &operator=(const CachedTokenStream &) = delete;
+    ~CachedTokenStream();
+    CompactToken operator[](size_t index) const;
+    Token expand(const CompactToken &token) const;
+    std::string_view getText(uint64_t id) const;
+    std::string_view getIndent(uint64_t id) const;
+    size_t size() const { return types.size(); }
+    size_t getSymbolCount() const { return symbolEnds.size(); }
+    size_t getIndentCount() const { return indentEnds.size(); }
+    std::span<const Token::TokenType> getTypes() const { return types; }
+    std::span<const Token::TokenSubtype> getSubtypes() const { return subtypes; }
+    std::span<const uint32_t> getOffsets() const { return offsets; }
+    std::span<const CompactToken::PayloadKind> getPayloadKinds() const { return payloadKinds; }
+    std::span<const uint64_t> getPayloads() const { return payloads; }
+
+private:
+    friend class TokenCache;
+    CachedTokenStream(const char *mapping, size_t mappingSize);
+    bool hasValidSymbols(uint64_t textSize) const;
+    std::string_view getEntryText(uint64_t entry) const;
+    const char *mapping;
+    size_t mappingSize;
+    std::span<const uint64_t> payloads;
+    std::span<const uint64_t> symbolEnds;
+    std::span<const uint64_t> indentEnds;
+    std::span<const uint32_t> offsets;
+    std::span<const Token::TokenType> types;
+    std::span<const Token::TokenSubtype> subtypes;
+    std::span<const CompactToken::PayloadKind> payloadKinds;
+    const char *text;
+};
+
+using CachedTokenStreamUptr = std::unique_ptr<CachedTokenStream>;
+
+class TokenCache
+{
+public:
+    TokenCache(const std::filesystem::path &directory,
+               LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep);
+    CachedTokenStreamUptr load(std::string_view source) const;
+    void store(std::string_view source, const TokenStream &stream, const TokenTables &tables) const;
+    CachedTokenStreamUptr tokenize(std::string_view source) const;
+    std::filesystem::path getEntryPath(std::string_view source) const;
+
+private:
+    CachedTokenStreamUptr load(std::string_view source, uint64_t sourceHash) const;
+    void store(std::string_view source, uint64_t sourceHash, const TokenStream &stream,
+               const TokenTables &tables) const;
+    std::filesystem::path entryPath(uint64_t sourceHash) const;
+    std::filesystem::path directory;
+    LexicalAnalyzer::CommentMode commentMode;
+};
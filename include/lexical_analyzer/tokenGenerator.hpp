@@ -0,0 +1,73 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include "lexicalAnalyzer.hpp"
+
+class TokenGenerator
+{
+public:
+    struct promise_type
+    {
+        TokenGenerator get_return_object() { return TokenGenerator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(Token value)
+        {
+            token = std::move(value);
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::optional<Token> token;
+        std::exception_ptr exception;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    TokenGenerator(TokenGenerator &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    TokenGenerator &operator=(TokenGenerator &&other) noexcept
+    {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~TokenGenerator()
+    {
+        if (handle)
+            handle.destroy();
+    }
+    // Empty either when the generator is done or when it is suspended waiting for more input.
+    std::optional<Token> next();
+    bool done() const { return !handle || handle.done(); }
+
+private:
+    explicit TokenGenerator(Handle handle) : handle(handle) {}
+    Handle handle;
+};
+
+class TokenFeed
+{
+public:
+    explicit TokenFeed(LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep,
+                       LexicalAnalyzer::ErrorMode errorMode = LexicalAnalyzer::ErrorMode::Throw)
+        : generator(lex(source, commentMode, errorMode)) {}
+    TokenFeed(const TokenFeed &) = delete;
+    TokenFeed &operator=(const TokenFeed &) = delete;
+    void push(std::string_view data) { source.push(data); }
+    void finish() { source.finish(); }
+    std::optional<Token> next() { return generator.next(); }
+    bool done() const { return generator.done(); }
+    Position resolvePosition(uint64_t absolutePosition) const { return source.resolvePosition(absolutePosition); }
+
+private:
+    static TokenGenerator lex(FeedSource &source, LexicalAnalyzer::CommentMode commentMode,
+                              LexicalAnalyzer::ErrorMode errorMode);
+    FeedSource source;
+    TokenGenerator generator;
+};
+
+TokenGenerator generateTokens(SourceBase &source,
+                              LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep,
+                              LexicalAnalyzer::ErrorMode errorMode = LexicalAnalyzer::ErrorMode::Throw);
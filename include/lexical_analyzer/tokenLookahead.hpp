@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+#include "lexicalAnalyzer.hpp"
+
+template <size_t Capacity>
+class TokenLookahead
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Lookahead capacity must be a power of two");
+
+public:
+    explicit TokenLookahead(LexicalAnalyzer &lexicalAnalyzer) : lexicalAnalyzer(lexicalAnalyzer)
+    {
+        marks.reserve(Capacity);
+    }
+
+    const Token &peek(size_t distance = 0)
+    {
+        uint64_t index = position + distance;
+        if (index - oldestLiveToken() >= Capacity)
+            throw LookaheadOutOfRange("Token lookahead reaches beyond the buffered window.");
+        for (; filled <= index; ++filled)
+            slots[filled & MASK] = lexicalAnalyzer.getToken();
+        return *slots[index & MASK];
+    }
+
+    // The returned token stays valid until the next consume(); its slot is kept out of the peek window.
+    const Token &consume()
+    {
+        const Token &token = peek();
+        ++position;
+        return token;
+    }
+
+    void mark() { marks.push_back(position); }
+
+    void rewind()
+    {
+        if (marks.empty())
+            throw LookaheadOutOfRange("There is no token mark to rewind to.");
+        position = marks.back();
+        marks.pop_back();
+    }
+
+    void release()
+    {
+        if (marks.empty())
+            throw LookaheadOutOfRange("There is no token mark to release.");
+        marks.pop_back();
+    }
+
+    uint64_t getPosition() const { return position; }
+    static constexpr size_t getCapacity() { return Capacity; }
+
+private:
+    uint64_t oldestLiveToken() const
+    {
+        uint64_t consumed = position > 0 ? position - 1 : 0;
+        return marks.empty() ? consumed : std::min(marks.front(), consumed);
+    }
+    static const uint64_t MASK = Capacity - 1;
+    LexicalAnalyzer &lexicalAnalyzer;
+    std::array<std::optional<Token>, Capacity> slots;
+    std::vector<uint64_t> marks;
+    uint64_t position = 0;
+    uint64_t filled = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "lexicalAnalyzer.hpp"
+#include "helpers/spscQueue.hpp"
+
+class TokenPipeline
+{
+public:
+    TokenPipeline(SourceBase &source, LexicalAnalyzer::CommentMode commentMode = LexicalAnalyzer::CommentMode::Keep,
+                  LexicalAnalyzer::ErrorMode errorMode = LexicalAnalyzer::ErrorMode::Throw,
+                  size_t batchSize = DEFAULT_BATCH_SIZE);
+    TokenPipeline(const TokenPipeline &) = delete;
+    TokenPipeline &operator=(const TokenPipeline &) = delete;
+    ~TokenPipeline();
+    std::optional<Token> getToken();
+    static const size_t DEFAULT_BATCH_SIZE = 512;
+    static const size_t QUEUE_CAPACITY = 8;
+
+private:
+    struct Batch
+    {
+        std::vector<Token> tokens;
+        std::exception_ptr error;
+    };
+
+    void produce();
+    void publish(Batch &batch);
+    void nextBatch();
+    LexicalAnalyzer lexicalAnalyzer;
+    size_t batchSize;
+    Containers::SpscQueue<Batch, QUEUE_CAPACITY> batches;
+    Containers::SpscQueue<Batch, QUEUE_CAPACITY> freeBatches;
+    Batch current;
+    size_t position = 0;
+    std::exception_ptr error;
+    std::optional<Token> endOfFile;
+    std::atomic<bool> stopping = false;
+    std::thread producer;
+};
+
+using TokenPipelineUptr = std::unique_ptr<TokenPipeline>;
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "compactToken.hpp"
+
+struct TokenTables
+{
+    SymbolTable symbolTable;
+    // Indentation of Open/CloseBlock tokens, kept apart so symbol ids only cover identifiers,
+    // comments and string literals.
+    SymbolTable indentTable;
+    std::vector<Matrix> matrices;
+
+    Token expand(const CompactToken &token, uint64_t absolutePosition) const;
+};
+
+// Symbol, Text and Matrix payloads are ids into the TokenTables of the analyzer that filled the
+// stream. The stream shares ownership of those tables, so it can be expanded after the analyzer
+// is gone, but symbols lexed from an in-memory source are views into it: that source must still
+// outlive the stream.
+class TokenStream
+{
+public:
+    void reserve(size_t tokenCount);
+    void push(const CompactToken &token);
+    void clear();
+    void splice(size_t first, size_t last, const TokenStream &replacement, int64_t offsetDelta);
+    void remapSymbols(const std::vector<uint32_t> &symbolIds);
+    CompactToken operator[](size_t index) const;
+    Token expand(size_t index) const;
+    void setTables(std::shared_ptr<const TokenTables> tables) { this->tables = std::move(tables); }
+    const std::shared_ptr<const TokenTables> &getTables() const { return tables; }
+    size_t size() const { return types.size(); }
+    bool empty() const { return types.empty(); }
+    const std::vector<Token::TokenType> &getTypes() const { return types; }
+    const std::vector<Token::TokenSubtype> &getSubtypes() const { return subtypes; }
+    const std::vector<uint32_t> &getOffsets() const { return offsets; }
+    const std::vector<CompactToken::PayloadKind> &getPayloadKinds() const { return payloadKinds; }
+    const std::vector<uint64_t> &getPayloads() const { return payloads; }
+    static size_t estimateTokenCount(uint64_t byteCount) { return byteCount / AVERAGE_TOKEN_BYTES + 1; }
+    static const uint64_t AVERAGE_TOKEN_BYTES = 4;
+
+private:
+    std::vector<Token::TokenType> types;
+    std::vector<Token::TokenSubtype> subtypes;
+    std::vector<uint32_t> offsets;
+    std::vector<CompactToken::PayloadKind> payloadKinds;
+    std::vector<uint64_t> payloads;
+    std::shared_ptr<const TokenTables> tables;
+};
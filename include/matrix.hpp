@@ -1,17 +1,210 @@
 #pragma once
-#include <vector>
-#include <variant>
-// TODO IMPLEMENT THIS
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "helpers/exception.hpp"
+
+// Row-major storage of one element type, with each row following the previous one without padding.
 class Matrix
 {
 public:
+    enum class ElementType : uint8_t
+    {
+        Integer,
+        Double,
+    };
+
+    static const size_t ALIGNMENT = 64;
+
+    Matrix() = default;
+    Matrix(uint32_t rows, uint32_t columns, ElementType elementType = ElementType::Integer);
+    Matrix(uint32_t rows, uint32_t columns, std::initializer_list<double> values);
+
+    template <std::integral T>
+    Matrix(uint32_t rows, uint32_t columns, std::initializer_list<T> values)
+        : Matrix(checkValueCount(rows, columns, values.size()), columns, ElementType::Integer)
+    {
+        std::copy(values.begin(), values.end(), elements<int64_t>());
+    }
+
+    Matrix(const Matrix &other);
+    Matrix(Matrix &&other) noexcept;
+    Matrix &operator=(const Matrix &other);
+    Matrix &operator=(Matrix &&other) noexcept;
+    uint32_t getRows() const { return rows; }
+    uint32_t getColumns() const { return columns; }
+    size_t size() const { return static_cast<size_t>(rows) * columns; }
+    ElementType getElementType() const { return elementType; }
+
+    template <class T>
+    std::span<T> getValues()
+    {
+        return std::span<T>(elements<T>(), size());
+    }
+
+    template <class T>
+    std::span<const T> getValues() const
+    {
+        return std::span<const T>(elements<T>(), size());
+    }
+
+    template <class T>
+    T &at(uint32_t row, uint32_t column)
+    {
+        return elements<T>()[index(row, column)];
+    }
+
+    template <class T>
+    const T &at(uint32_t row, uint32_t column) const
+    {
+        return elements<T>()[index(row, column)];
+    }
+
+    Matrix &operator+=(const Matrix &other);
+    Matrix &operator-=(const Matrix &other);
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    Matrix &operator*=(T factor)
+    {
+        scale(*this, factor, false, *this);
+        return *this;
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    Matrix &operator/=(T divisor)
+    {
+        scale(*this, divisor, true, *this);
+        return *this;
+    }
+
 private:
-    unsigned int columns;
-    unsigned int rows;
-    std::vector<std::variant<double, int>> values;
+    struct AlignedDelete
+    {
+        void operator()(std::byte *storage) const { ::operator delete(storage, std::align_val_t(ALIGNMENT)); }
+    };
+
+    static uint32_t checkValueCount(uint32_t rows, uint32_t columns, size_t count);
+    void allocate();
+    Matrix emptyLike() const;
+    static void add(const Matrix &lhs, const Matrix &rhs, Matrix &result);
+    static void subtract(const Matrix &lhs, const Matrix &rhs, Matrix &result);
+    static void scaleIntegers(const Matrix &matrix, int64_t factor, bool divide, Matrix &result);
+    static void scaleDoubles(const Matrix &matrix, double factor, bool divide, Matrix &result);
+
+    // Double matrices take any arithmetic scalar, integer matrices only integral ones.
+    template <class T>
+    static void scale(const Matrix &matrix, T factor, bool divide, Matrix &result)
+    {
+        if (matrix.elementType == ElementType::Double)
+            scaleDoubles(matrix, static_cast<double>(factor), divide, result);
+        else if constexpr (std::is_integral_v<T>)
+            scaleIntegers(matrix, static_cast<int64_t>(factor), divide, result);
+        else
+            throw MatrixTypeMismatch("Integer matrix cannot be scaled by a floating point number.");
+    }
+
+    size_t index(uint32_t row, uint32_t column) const
+    {
+        if (row >= rows || column >= columns)
+            throw MatrixIndexOutOfRange("Matrix element is outside of the matrix dimensions.");
+        return static_cast<size_t>(row) * columns + column;
+    }
+
+    template <class T>
+    T *elements() const
+    {
+        static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>, "Matrix holds int64_t or double");
+        if (elementType != (std::is_same_v<T, int64_t> ? ElementType::Integer : ElementType::Double))
+            throw MatrixTypeMismatch("Matrix elements are of a different type.");
+        return reinterpret_cast<T *>(storage.get());
+    }
+
+    template <class T>
+    bool sameValues(const Matrix &other) const
+    {
+        return std::equal(elements<T>(), elements<T>() + size(), other.elements<T>());
+    }
+
+    uint32_t rows = 0;
+    uint32_t columns = 0;
+    ElementType elementType = ElementType::Integer;
+    std::unique_ptr<std::byte, AlignedDelete> storage;
 
     friend bool operator==(Matrix const &lhs, Matrix const &rhs)
     {
-        return  lhs.values == rhs.values;
+        if (lhs.rows != rhs.rows || lhs.columns != rhs.columns || lhs.elementType != rhs.elementType)
+            return false;
+        return lhs.elementType == ElementType::Integer ? lhs.sameValues<int64_t>(rhs) : lhs.sameValues<double>(rhs);
     };
-};
\ No newline at end of file
+
+    friend Matrix operator+(const Matrix &lhs, const Matrix &rhs)
+    {
+        Matrix result = lhs.emptyLike();
+        add(lhs, rhs, result);
+        return result;
+    }
+
+    friend Matrix operator+(Matrix &&lhs, const Matrix &rhs)
+    {
+        return std::move(lhs += rhs);
+    }
+
+    friend Matrix operator-(const Matrix &lhs, const Matrix &rhs)
+    {
+        Matrix result = lhs.emptyLike();
+        subtract(lhs, rhs, result);
+        return result;
+    }
+
+    friend Matrix operator-(Matrix &&lhs, const Matrix &rhs)
+    {
+        return std::move(lhs -= rhs);
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    friend Matrix operator*(const Matrix &matrix, T factor)
+    {
+        Matrix result = matrix.emptyLike();
+        scale(matrix, factor, false, result);
+        return result;
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    friend Matrix operator*(Matrix &&matrix, T factor)
+    {
+        return std::move(matrix *= factor);
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    friend Matrix operator*(T factor, const Matrix &matrix)
+    {
+        return matrix * factor;
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    friend Matrix operator/(const Matrix &matrix, T divisor)
+    {
+        Matrix result = matrix.emptyLike();
+        scale(matrix, divisor, true, result);
+        return result;
+    }
+
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    friend Matrix operator/(Matrix &&matrix, T divisor)
+    {
+        return std::move(matrix /= divisor);
+    }
+};
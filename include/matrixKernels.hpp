@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Element-wise kernels over equally sized spans. The result may alias either operand.
+namespace MatrixKernels
+{
+    enum class Kernel : uint8_t
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+    };
+
+    Kernel bestKernel();
+    template <class T>
+    void add(std::span<const T> lhs, std::span<const T> rhs, std::span<T> result, Kernel kernel = bestKernel());
+    template <class T>
+    void subtract(std::span<const T> lhs, std::span<const T> rhs, std::span<T> result, Kernel kernel = bestKernel());
+    template <class T>
+    void multiply(std::span<const T> values, T factor, std::span<T> result, Kernel kernel = bestKernel());
+    template <class T>
+    void divide(std::span<const T> values, T divisor, std::span<T> result, Kernel kernel = bestKernel());
+}
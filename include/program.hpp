@@ -6,16 +6,26 @@
 #include <mutex>
 #include <optional>
 #include <filesystem>
+#include <charconv>
 #include "helpers/sourceFactory.hpp"
 #include "helpers/flagResolver.hpp"
+#include "helpers/socketServer.hpp"
 #include "lexical_analyzer/lexicalAnalyzer.hpp"
+#include "lexical_analyzer/tokenCache.hpp"
+#include "lexical_analyzer/tokenPipeline.hpp"
 
 namespace Program
 {
     extern SourceSptr source;
     extern LexicalAnalyzerUptr lexicalAnalyzer;
+    extern CachedTokenStreamUptr cachedTokens;
+    extern TokenPipelineUptr tokenPipeline;
     void start(const int argc, const std::vector<std::string_view>& arguments);
     void startInterpreter();
     void parseFlags(const std::vector<std::string_view>& arguments);
+    void startServer(const std::vector<std::string_view>& arguments);
+    void loadCachedTokens(const std::vector<std::string_view>& arguments);
+    void printStatistics(const std::vector<std::string_view>& arguments);
+    std::string summarizeTokens(LexicalAnalyzer& analyzer);
     void showHelp();
 }
\ No newline at end of file
@@ -5,20 +5,24 @@
 #include <filesystem>
 #include <string>
 #include <memory>
-#include "helpers/position.hpp"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <algorithm>
+#include "helpers/lineIndex.hpp"
+#include "helpers/instrumentation.hpp"
 #include "helpers/socketWrapper.hpp"
 
 struct NextCharacter
 {
     NextCharacter() = default;
-    NextCharacter(char letter, uint64_t aPos, uint64_t cPos, uint64_t lPos) : nextLetter(letter), absolutePosition(aPos),
-                                                                              characterPosition(cPos), linePosition(lPos) {}
-    std::string getLinePosition() const { return std::to_string(characterPosition) + ":" + std::to_string(linePosition); }
+    NextCharacter(char letter, uint64_t aPos) : nextLetter(letter), absolutePosition(aPos) {}
 
     char nextLetter;
     uint64_t absolutePosition;
-    uint64_t characterPosition;
-    uint64_t linePosition;
 };
 
 class SourceBase
@@ -28,9 +32,43 @@ public:
     virtual NextCharacter getChar()=0;
     virtual void close()=0;
     NextCharacter getCurrentCharacter() const { return currentCharacter; }
+    Position resolvePosition(uint64_t absolutePosition) const { return lineIndex.resolve(absolutePosition); }
+    std::string getLinePosition(uint64_t absolutePosition) const { return lineIndex.describe(absolutePosition); }
+    virtual uint64_t getSizeHint() const { return 0; }
+    virtual std::string_view getBuffer() const { return {}; }
+#ifdef TKOM_INSTRUMENTATION
+    const Instrumentation::SourceStatistics &getStatistics() const { return statistics; }
+#endif
     virtual ~SourceBase() = default;
 protected:
+    friend class LexicalAnalyzer;
+    // Only sources exposing their whole contents through getBuffer() read the character at
+    // position; the others would keep reading from their stream, so the lexer alone may seek.
+    NextCharacter seek(uint64_t absolutePosition)
+    {
+        position = absolutePosition;
+        return getChar();
+    }
+    NextCharacter emitChar(char letter)
+    {
+        currentCharacter = NextCharacter(letter, position);
+        if (letter == '\n')
+            lineIndex.addLineStart(position + 1);
+        ++position;
+        return currentCharacter;
+    }
+    void rewind()
+    {
+        position = 0;
+        lineIndex.clear();
+    }
+
     NextCharacter currentCharacter;
+    uint64_t position = 0;
+    LineIndex lineIndex;
+#ifdef TKOM_INSTRUMENTATION
+    Instrumentation::SourceStatistics statistics;
+#endif
 };
 
 using SourceUptr = std::unique_ptr<SourceBase>;
@@ -42,15 +80,81 @@ public:
     void open() override;
     void close() override;
     NextCharacter getChar() override;
-    FileSource(const std::string_view filepath) : filepath(std::filesystem::path(filepath)),
-                                                   position(Position()){}
+    FileSource(const std::string_view filepath) : filepath(std::filesystem::path(filepath)){}
+    uint64_t getSizeHint() const override;
     ~FileSource(){
         close();
     }
 private:
     std::filesystem::path filepath;
     std::fstream fileSource;
-    Position position;
+};
+
+class MappedFileSource : public SourceBase
+{
+public:
+    void open() override;
+    void close() override;
+    NextCharacter getChar() override;
+    MappedFileSource(const std::string_view filepath) : filepath(std::filesystem::path(filepath)){}
+    uint64_t getSizeHint() const override { return mappingSize; }
+    std::string_view getBuffer() const override { return std::string_view(mapping, mappingSize); }
+    ~MappedFileSource(){
+        close();
+    }
+private:
+    std::filesystem::path filepath;
+    const char *mapping = nullptr;
+    uint64_t mappingSize = 0;
+};
+
+class ReadAheadFileSource : public SourceBase
+{
+public:
+    void open() override;
+    void close() override;
+    NextCharacter getChar() override;
+    ReadAheadFileSource(const std::string_view filepath, size_t bufferSize = DEFAULT_BUFFER_SIZE,
+                        size_t bufferCount = DEFAULT_BUFFER_COUNT)
+        : filepath(std::filesystem::path(filepath)), buffers(checkBufferCount(bufferSize, bufferCount), Buffer(bufferSize)){}
+    ~ReadAheadFileSource(){
+        close();
+    }
+    std::chrono::nanoseconds getReadTime() const { return readTime; }
+    std::chrono::nanoseconds getStallTime() const { return stallTime; }
+    std::chrono::nanoseconds getHiddenIoTime() const
+    {
+        return std::max(readTime - stallTime, std::chrono::nanoseconds::zero());
+    }
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 18;
+    static const size_t DEFAULT_BUFFER_COUNT = 3;
+private:
+    struct Buffer
+    {
+        Buffer(size_t size) : data(size), length(0) {}
+        std::vector<char> data;
+        size_t length;
+    };
+    static size_t checkBufferCount(size_t bufferSize, size_t bufferCount);
+    void readAhead();
+    bool nextBuffer();
+    std::filesystem::path filepath;
+    int descriptor = -1;
+    std::vector<Buffer> buffers;
+    uint64_t produced = 0;
+    uint64_t released = 0;
+    bool holdingBuffer = false;
+    bool endOfFile = false;
+    bool stopping = false;
+    std::exception_ptr readError;
+    std::mutex buffersMutex;
+    std::condition_variable buffersCondition;
+    std::thread reader;
+    const char *current = nullptr;
+    size_t currentPosition = 0;
+    size_t currentLength = 0;
+    std::chrono::nanoseconds readTime{0};
+    std::chrono::nanoseconds stallTime{0};
 };
 
 class SocketSource : public SourceBase
@@ -59,16 +163,24 @@ public:
     void open() override;
     void close() override;
     NextCharacter getChar() override;
-    SocketSource() : position(Position()){socketWrapper.initSocket();}
+    SocketSource(uint port = SocketWrapper::DEFAULT_PORT) : socketWrapper(port),
+                                                           buffer(BUFFER_SIZE){socketWrapper.initSocket();}
     void waitForData();
     int getPort() const { return socketWrapper.getPort(); }
+    uint64_t getReadCalls() const { return readCalls; }
     ~SocketSource(){
         close();
     }
 private:
+    bool fillBuffer();
+    static const size_t BUFFER_SIZE = 1 << 16;
     uint socketSource;
     SocketWrapper socketWrapper;
-    Position position;
+    std::vector<char> buffer;
+    size_t bufferPosition = 0;
+    size_t bufferLength = 0;
+    bool endOfStream = false;
+    uint64_t readCalls = 0;
 };
 
 class StringSource : public SourceBase
@@ -77,11 +189,29 @@ public:
     void open() override;
     void close() override {}
     NextCharacter getChar()override;
-    StringSource(const std::string_view codeSource) : stringSource(codeSource), position(Position()){}
+    StringSource(const std::string_view codeSource) : stringSource(codeSource){}
+    uint64_t getSizeHint() const override { return stringSource.size(); }
+    std::string_view getBuffer() const override { return stringSource; }
     ~StringSource(){
         close();
     }
 private:
     std::string_view stringSource;
-    Position position;
-};
\ No newline at end of file
+};
+
+class FeedSource : public SourceBase
+{
+public:
+    void open() override;
+    void close() override {}
+    NextCharacter getChar() override;
+    void push(std::string_view data);
+    void finish() { finished = true; }
+    bool hasCompleteLine();
+private:
+    static const size_t COMPACTION_THRESHOLD = 1 << 16;
+    std::string pending;
+    size_t readPosition = 0;
+    size_t searchPosition = 0;
+    bool finished = false;
+};
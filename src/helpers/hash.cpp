@@ -0,0 +1,83 @@
+#include "helpers/hash.hpp"
+#include <cstring>
+
+namespace
+{
+    const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    uint64_t rotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t read64(const char *data)
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint32_t read32(const char *data)
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    uint64_t round(uint64_t accumulator, uint64_t input)
+    {
+        accumulator += input * PRIME2;
+        return rotateLeft(accumulator, 31) * PRIME1;
+    }
+
+    uint64_t mergeRound(uint64_t accumulator, uint64_t value)
+    {
+        accumulator ^= round(0, value);
+        return accumulator * PRIME1 + PRIME4;
+    }
+}
+
+uint64_t Hash::xxHash64(std::string_view data, uint64_t seed)
+{
+    const char *position = data.data();
+    const char *end = position + data.size();
+    uint64_t hash;
+    if (data.size() >= 32)
+    {
+        uint64_t lanes[4] = {seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1};
+        for (; end - position >= 32; position += 32)
+        {
+            lanes[0] = round(lanes[0], read64(position));
+            lanes[1] = round(lanes[1], read64(position + 8));
+            lanes[2] = round(lanes[2], read64(position + 16));
+            lanes[3] = round(lanes[3], read64(position + 24));
+        }
+        hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+        for (uint64_t lane : lanes)
+            hash = mergeRound(hash, lane);
+    }
+    else
+    {
+        hash = seed + PRIME5;
+    }
+    hash += data.size();
+    for (; end - position >= 8; position += 8)
+        hash = rotateLeft(hash ^ round(0, read64(position)), 27) * PRIME1 + PRIME4;
+    if (end - position >= 4)
+    {
+        hash = rotateLeft(hash ^ (read32(position) * PRIME1), 23) * PRIME2 + PRIME3;
+        position += 4;
+    }
+    for (; position < end; ++position)
+        hash = rotateLeft(hash ^ (static_cast<unsigned char>(*position) * PRIME5), 11) * PRIME1;
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
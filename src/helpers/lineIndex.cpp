@@ -0,0 +1,14 @@
+#include "helpers/lineIndex.hpp"
+#include <algorithm>
+
+Position LineIndex::resolve(uint64_t absolutePosition) const
+{
+    auto lineStart = std::upper_bound(lineStarts.begin(), lineStarts.end(), absolutePosition) - 1;
+    return Position(absolutePosition, lineStart - lineStarts.begin(), absolutePosition - *lineStart);
+}
+
+std::string LineIndex::describe(uint64_t absolutePosition) const
+{
+    Position position = resolve(absolutePosition);
+    return std::to_string(position.getChar()) + ":" + std::to_string(position.getLine());
+}
@@ -0,0 +1,263 @@
+#include "helpers/socketServer.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    void setBlocking(int descriptor, bool blocking)
+    {
+        int flags = fcntl(descriptor, F_GETFL, 0);
+        fcntl(descriptor, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK);
+    }
+
+    void watch(int epollDescriptor, int descriptor, int operation = EPOLL_CTL_ADD, uint32_t events = EPOLLIN)
+    {
+        epoll_event event;
+        event.events = events;
+        event.data.fd = descriptor;
+        if (epoll_ctl(epollDescriptor, operation, descriptor, &event) == -1)
+            throw SocketProblemException("Cannot watch socket!");
+    }
+}
+
+SocketServer::SocketServer(uint port, uint workerCount, Handler handler, size_t maxProgramSize)
+    : handler(std::move(handler)), maxProgramSize(maxProgramSize), stopping(false)
+{
+    listeningSocket = SocketWrapper::openListeningSocket(port, SOMAXCONN);
+    try
+    {
+        sockaddr_in address;
+        socklen_t addressLength = sizeof address;
+        getsockname(listeningSocket, (struct sockaddr *)&address, &addressLength);
+        this->port = ntohs(address.sin_port);
+        setBlocking(listeningSocket, false);
+
+        epollDescriptor = epoll_create1(0);
+        stopDescriptor = eventfd(0, EFD_NONBLOCK);
+        if (epollDescriptor == -1 || stopDescriptor == -1)
+            throw SocketProblemException("Cannot create event queue!");
+        watch(epollDescriptor, listeningSocket);
+        watch(epollDescriptor, stopDescriptor);
+
+        for (uint i = 0; i < std::max(workerCount, 1u); ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+}
+
+SocketServer::~SocketServer()
+{
+    stop();
+    release();
+}
+
+// Joins the workers started so far and closes every descriptor that was opened, so it also
+// cleans up after a constructor that failed halfway.
+void SocketServer::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        stopping = true;
+        jobsCondition.notify_all();
+    }
+    for (auto &worker : workers)
+        worker.join();
+    for (auto &pending : pendingPrograms)
+        close(pending.first);
+    for (int descriptor : {listeningSocket, epollDescriptor, stopDescriptor})
+    {
+        if (descriptor != -1)
+            close(descriptor);
+    }
+}
+
+void SocketServer::stop()
+{
+    stopping = true;
+    uint64_t signal = 1;
+    write(stopDescriptor, &signal, sizeof signal);
+}
+
+void SocketServer::run()
+{
+    epoll_event events[MAX_EVENTS];
+    while (!stopping)
+    {
+        int timeout = acceptPaused ? ACCEPT_BACKOFF.count() : -1;
+        int ready = epoll_wait(epollDescriptor, events, MAX_EVENTS, timeout);
+        if (ready == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            throw SocketProblemException("Cannot wait for socket events!");
+        }
+        if (acceptPaused && std::chrono::steady_clock::now() >= acceptResumeTime)
+            resumeAccepting();
+        for (int i = 0; i < ready; ++i)
+        {
+            int descriptor = events[i].data.fd;
+            if (descriptor == stopDescriptor)
+                break;
+            else if (descriptor == listeningSocket)
+                acceptConnections();
+            else
+                receive(descriptor);
+        }
+    }
+    std::lock_guard<std::mutex> lock(jobsMutex);
+    jobsCondition.notify_all();
+}
+
+void SocketServer::acceptConnections()
+{
+    for (;;)
+    {
+        int connection = accept4(listeningSocket, nullptr, nullptr, SOCK_NONBLOCK);
+        if (connection != -1)
+            registerConnection(connection);
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return;
+        else if (errno != ECONNABORTED && errno != EINTR)
+            return pauseAccepting();
+    }
+}
+
+// A connection that cannot be added to the event set is closed on its own so the
+// server keeps serving the others.
+void SocketServer::registerConnection(int connection)
+{
+    try
+    {
+        watch(epollDescriptor, connection);
+    }
+    catch (SocketProblemException &ex)
+    {
+        int error = errno;
+        std::cerr << ex.what() << " " << std::strerror(error) << std::endl;
+        close(connection);
+        return;
+    }
+    pendingPrograms.emplace(connection, PendingProgram());
+}
+
+// The listener is level-triggered, so when accepting fails for a reason other than
+// an aborted connection (e.g. descriptors are exhausted) it is taken out of the
+// event set and retried after a backoff instead of spinning.
+void SocketServer::pauseAccepting()
+{
+    std::cerr << "Cannot accept connection: " << std::strerror(errno) << ", retrying in "
+              << ACCEPT_BACKOFF.count() << " ms" << std::endl;
+    watch(epollDescriptor, listeningSocket, EPOLL_CTL_MOD, 0);
+    acceptPaused = true;
+    acceptResumeTime = std::chrono::steady_clock::now() + ACCEPT_BACKOFF;
+}
+
+void SocketServer::resumeAccepting()
+{
+    watch(epollDescriptor, listeningSocket, EPOLL_CTL_MOD);
+    acceptPaused = false;
+}
+
+void SocketServer::receive(int connection)
+{
+    char buffer[RECEIVE_SIZE];
+    for (;;)
+    {
+        ssize_t received = read(connection, buffer, sizeof buffer);
+        if (received > 0)
+        {
+            PendingProgram &pending = pendingPrograms[connection];
+            if (pending.program.size() + received > maxProgramSize)
+            {
+                pending.tooLarge = true;
+                std::string().swap(pending.program);
+            }
+            if (!pending.tooLarge)
+                pending.program.append(buffer, received);
+        }
+        else if (received == 0)
+            return dispatch(connection);
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return;
+        else if (errno != EINTR)
+            return dropConnection(connection);
+    }
+}
+
+void SocketServer::dispatch(int connection)
+{
+    epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, connection, nullptr);
+    setBlocking(connection, true);
+    auto pending = pendingPrograms.find(connection);
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push(Job{connection, std::move(pending->second.program), pending->second.tooLarge});
+    }
+    pendingPrograms.erase(pending);
+    jobsCondition.notify_one();
+}
+
+void SocketServer::dropConnection(int connection)
+{
+    epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, connection, nullptr);
+    pendingPrograms.erase(connection);
+    close(connection);
+}
+
+void SocketServer::workerLoop()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            jobsCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+        respond(job);
+    }
+}
+
+void SocketServer::respond(Job &job)
+{
+    std::string response;
+    if (job.tooLarge)
+        response = "Program exceeds the maximum size accepted by the server!\n";
+    else
+    {
+        try
+        {
+            StringSource source(job.program);
+            LexicalAnalyzer lexicalAnalyzer(source, LexicalAnalyzer::CommentMode::Discard);
+            response = handler(lexicalAnalyzer);
+        }
+        catch (std::exception &ex)
+        {
+            response = std::string(ex.what()) + "\n";
+        }
+    }
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+        ssize_t written = send(job.connection, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (written == -1 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            break;
+        sent += written;
+    }
+    close(job.connection);
+}
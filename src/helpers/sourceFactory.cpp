@@ -4,7 +4,19 @@ SourceUptr SourceFactory::createSource(FlagResolver::Options option,
 {
     switch(option){
         case(FlagResolver::Options::File):
+        case(FlagResolver::Options::Pipeline):
+        {
+            std::error_code error;
+            auto fileSize = std::filesystem::file_size(arguments[2], error);
+            if (!error && fileSize >= MAPPED_FILE_THRESHOLD)
+                return std::make_unique<MappedFileSource>(arguments[2]);
             return std::make_unique<FileSource>(arguments[2]);
+        }
+        case(FlagResolver::Options::MappedFile):
+        case(FlagResolver::Options::CachedFile):
+            return std::make_unique<MappedFileSource>(arguments[2]);
+        case(FlagResolver::Options::StreamedFile):
+            return std::make_unique<ReadAheadFileSource>(arguments[2]);
         case(FlagResolver::Options::Socket):
             return std::make_unique<SocketSource>();
         case(FlagResolver::Options::String):
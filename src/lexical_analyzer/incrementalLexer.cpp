@@ -0,0 +1,182 @@
+#include "lexical_analyzer/incrementalLexer.hpp"
+#include <algorithm>
+#include "helpers/replaceRange.hpp"
+using namespace Containers;
+
+IncrementalLexer::IncrementalLexer(std::string text, LexicalAnalyzer::CommentMode commentMode)
+    : text(std::move(text)), commentMode(commentMode)
+{
+    if (this->text.size() > UINT32_MAX)
+        throw SourceTooLargeException("Source is beyond the compact token range.");
+    IndentState initialState{{}, 0};
+    initialState.indentStack.push("");
+    indentStates.push_back(initialState);
+    lines.push_back(Line{0, 0});
+    stream.setTables(tables);
+    relex(0, 0, 0);
+}
+
+void IncrementalLexer::edit(uint64_t offset, uint64_t removedLength, std::string_view insertedText)
+{
+    if (offset > text.size() || removedLength > text.size() - offset)
+        throw InvalidSourceEdit("Edited range is outside of the source.");
+    if (text.size() - removedLength + insertedText.size() > UINT32_MAX)
+        throw SourceTooLargeException("Edited source is beyond the compact token range.");
+    text.replace(offset, removedLength, insertedText);
+    auto line = std::upper_bound(lines.begin(), lines.end(), offset,
+                                 [](uint64_t position, const Line &line) { return position < line.start; });
+    relex(line - lines.begin() - 1, offset + insertedText.size(),
+          static_cast<int64_t>(insertedText.size()) - static_cast<int64_t>(removedLength));
+}
+
+void IncrementalLexer::relex(size_t firstLine, uint64_t editEnd, int64_t delta)
+{
+    uint64_t lineStart = lines[firstLine].start;
+    const std::vector<uint32_t> &offsets = stream.getOffsets();
+    size_t firstToken = std::lower_bound(offsets.begin(), offsets.end(), lineStart) - offsets.begin();
+    size_t lastToken = offsets.size();
+    size_t lastLine = lines.size();
+
+    StringSource source(std::string_view(text).substr(lineStart));
+    LexicalAnalyzer analyzer(source, commentMode, LexicalAnalyzer::ErrorMode::Collect);
+    analyzer.indentStack = indentStates[lines[firstLine].indentState].indentStack;
+    analyzer.chosenIndentChar = indentStates[lines[firstLine].indentState].chosenIndentChar;
+    TokenStream replacement;
+    std::vector<Line> replacementLines{lines[firstLine]};
+    std::vector<uint32_t> symbols;
+    bool indentChanged = false;
+    for (size_t oldLine = firstLine;;)
+    {
+        CompactToken token = *analyzer.getCompactToken();
+        token.absolutePosition += lineStart;
+        if (token.payloadKind == CompactToken::PayloadKind::Symbol)
+            token.index = remapSymbol(analyzer, token.index, symbols);
+        else if (token.payloadKind == CompactToken::PayloadKind::Text)
+            token.index = tables->indentTable.intern(analyzer.tables->indentTable.getText(token.index)).id;
+        replacement.push(token);
+        if (token.type == Token::TokenType::EndOfFileToken)
+            break;
+        if (token.type == Token::TokenType::OpenBlockToken || token.type == Token::TokenType::CloseBlockToken ||
+            token.type == Token::TokenType::ErrorToken)
+            indentChanged = true;
+        if (token.type != Token::TokenType::NextLineToken)
+            continue;
+        uint64_t nextStart = token.absolutePosition + 1;
+        uint32_t indentState = replacementLines.back().indentState;
+        if (indentChanged)
+            indentState = captureIndentState(analyzer, indentState);
+        indentChanged = false;
+        if (nextStart >= editEnd)
+        {
+            uint64_t oldStart = nextStart - delta;
+            while (oldLine < lines.size() && lines[oldLine].start < oldStart)
+                ++oldLine;
+            if (oldLine < lines.size() && lines[oldLine].start == oldStart &&
+                sameIndentState(lines[oldLine].indentState, indentState))
+            {
+                lastToken = std::lower_bound(offsets.begin(), offsets.end(), oldStart) - offsets.begin();
+                lastLine = oldLine;
+                break;
+            }
+        }
+        replacementLines.push_back(Line{static_cast<uint32_t>(nextStart), indentState});
+    }
+
+    uint64_t oldEnd = lastLine < lines.size() ? lines[lastLine].start : UINT64_MAX;
+    auto byPosition = [](const Diagnostic &diagnostic, uint64_t position) { return diagnostic.absolutePosition < position; };
+    auto firstDiagnostic = std::lower_bound(diagnostics.begin(), diagnostics.end(), lineStart, byPosition);
+    auto lastDiagnostic = std::lower_bound(firstDiagnostic, diagnostics.end(), oldEnd, byPosition);
+    for (auto diagnostic = lastDiagnostic; diagnostic != diagnostics.end(); ++diagnostic)
+        diagnostic->absolutePosition += delta;
+    std::vector<Diagnostic> replacementDiagnostics = analyzer.getDiagnostics();
+    for (Diagnostic &diagnostic : replacementDiagnostics)
+        diagnostic.absolutePosition += lineStart;
+    firstDiagnostic = diagnostics.erase(firstDiagnostic, lastDiagnostic);
+    diagnostics.insert(firstDiagnostic, replacementDiagnostics.begin(), replacementDiagnostics.end());
+
+    if (delta != 0)
+    {
+        for (size_t line = lastLine; line < lines.size(); ++line)
+            lines[line].start += delta;
+    }
+    replaceRange(lines, firstLine, lastLine, replacementLines);
+    stream.splice(firstToken, lastToken, replacement, delta);
+    relexedTokenCount = replacement.size();
+    if (indentStates.size() > 2 * lines.size())
+        compactIndentStates();
+    if (tables->symbolTable.size() > 2 * stream.size())
+        compactSymbols();
+}
+
+uint32_t IncrementalLexer::captureIndentState(const LexicalAnalyzer &analyzer, uint32_t previous)
+{
+    const IndentState &state = indentStates[previous];
+    if (state.chosenIndentChar == analyzer.chosenIndentChar && state.indentStack == analyzer.indentStack)
+        return previous;
+    indentStates.push_back(IndentState{analyzer.indentStack, analyzer.chosenIndentChar});
+    return indentStates.size() - 1;
+}
+
+bool IncrementalLexer::sameIndentState(uint32_t first, uint32_t second) const
+{
+    return first == second ||
+           (indentStates[first].chosenIndentChar == indentStates[second].chosenIndentChar &&
+            indentStates[first].indentStack == indentStates[second].indentStack);
+}
+
+void IncrementalLexer::compactIndentStates()
+{
+    std::vector<uint32_t> remapped(indentStates.size(), UINT32_MAX);
+    std::vector<IndentState> usedStates;
+    for (Line &line : lines)
+    {
+        if (remapped[line.indentState] == UINT32_MAX)
+        {
+            remapped[line.indentState] = usedStates.size();
+            usedStates.push_back(std::move(indentStates[line.indentState]));
+        }
+        line.indentState = remapped[line.indentState];
+    }
+    indentStates = std::move(usedStates);
+}
+
+// Every edit interns the text it lexes, so symbols left behind by earlier edits (e.g. the
+// prefixes of an identifier being typed) are dropped by rebuilding the table from the stream.
+void IncrementalLexer::compactSymbols()
+{
+    std::vector<uint32_t> remapped(tables->symbolTable.size(), UINT32_MAX);
+    SymbolTable usedSymbols;
+    const std::vector<CompactToken::PayloadKind> &payloadKinds = stream.getPayloadKinds();
+    const std::vector<uint64_t> &payloads = stream.getPayloads();
+    for (size_t index = 0; index < stream.size(); ++index)
+    {
+        if (payloadKinds[index] != CompactToken::PayloadKind::Symbol)
+            continue;
+        uint64_t id = payloads[index];
+        if (remapped[id] == UINT32_MAX)
+            remapped[id] = usedSymbols.intern(tables->symbolTable.getText(id)).id;
+    }
+    stream.remapSymbols(remapped);
+    tables->symbolTable = std::move(usedSymbols);
+}
+
+uint32_t IncrementalLexer::remapSymbol(const LexicalAnalyzer &analyzer, uint64_t id, std::vector<uint32_t> &symbols)
+{
+    if (id >= symbols.size())
+        symbols.resize(analyzer.getSymbolTable().size(), UINT32_MAX);
+    if (symbols[id] == UINT32_MAX)
+        symbols[id] = tables->symbolTable.intern(analyzer.getSymbolTable().getText(id)).id;
+    return symbols[id];
+}
+
+Token IncrementalLexer::expand(size_t index) const
+{
+    return stream.expand(index);
+}
+
+Position IncrementalLexer::resolvePosition(uint64_t absolutePosition) const
+{
+    auto line = std::upper_bound(lines.begin(), lines.end(), absolutePosition,
+                                 [](uint64_t position, const Line &line) { return position < line.start; }) - 1;
+    return Position(absolutePosition, line - lines.begin(), absolutePosition - line->start);
+}
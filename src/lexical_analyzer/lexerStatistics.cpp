@@ -0,0 +1,123 @@
+#include "lexical_analyzer/lexerStatistics.hpp"
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace
+{
+    const char *TOKEN_TYPE_NAMES[] = {
+        "MatrixToken",
+        "IntegerToken",
+        "TextToken",
+        "DoubleToken",
+        "AdditiveOperatorToken",
+        "MultiplicativeOperatorToken",
+        "RelationalOperatorToken",
+        "LogicalOperatorToken",
+        "AssignmentOperatorToken",
+        "IfToken",
+        "OtherwiseToken",
+        "LoopToken",
+        "AsLongAsToken",
+        "FunctionToken",
+        "ConditionToken",
+        "CaseToken",
+        "DefaultToken",
+        "IdentifierToken",
+        "OpenRoundBracketToken",
+        "CloseRoundBracketToken",
+        "OpenSquareBracketToken",
+        "CloseSquareBracketToken",
+        "ColonToken",
+        "OpenBlockToken",
+        "CloseBlockToken",
+        "CommaToken",
+        "PointToken",
+        "VoidToken",
+        "ContinueToken",
+        "BreakToken",
+        "TrueToken",
+        "FalseToken",
+        "CommentToken",
+        "EndOfFileToken",
+        "UnindentifiedToken",
+        "NextLineToken",
+        "AndToken",
+        "OrToken",
+        "NotToken",
+        "StringLiteralToken",
+        "IntegerLiteralToken",
+        "DoubleLiteralToken",
+        "DetToken",
+        "TransToken",
+        "InvToken",
+        "ReturnToken",
+        "ErrorToken",
+    };
+
+    const char *PHASE_NAMES[] = {"indentation", "whitespace", "identifiers", "numbers",
+                                 "strings", "comments", "operators", "other"};
+
+    static_assert(std::size(TOKEN_TYPE_NAMES) == LexerStatistics::TOKEN_TYPE_COUNT);
+    static_assert(std::size(PHASE_NAMES) == LexerStatistics::PHASE_COUNT);
+
+    void printLine(std::ostringstream &report, const std::string &name, uint64_t value)
+    {
+        report << std::left << std::setw(36) << name << std::right << std::setw(16) << value << "\n";
+    }
+}
+
+const char *LexerStatistics::getName(Token::TokenType type)
+{
+    return TOKEN_TYPE_NAMES[static_cast<size_t>(type)];
+}
+
+const char *LexerStatistics::getName(Phase phase)
+{
+    return PHASE_NAMES[static_cast<size_t>(phase)];
+}
+
+uint64_t LexerStatistics::getTokenCount() const
+{
+    return std::accumulate(tokenCounts.begin(), tokenCounts.end(), uint64_t(0));
+}
+
+std::string LexerStatistics::toText() const
+{
+    std::ostringstream report;
+    printLine(report, "tokens", getTokenCount());
+    for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+    {
+        if (tokenCounts[type] != 0)
+            printLine(report, std::string("  ") + TOKEN_TYPE_NAMES[type], tokenCounts[type]);
+    }
+    printLine(report, "bytes consumed", bytesConsumed);
+    printLine(report, "source refills", sourceStatistics.refills);
+    printLine(report, "source system calls", sourceStatistics.systemCalls);
+    printLine(report, "max indent depth", maxIndentDepth);
+    printLine(report, "cycles", std::accumulate(phaseCycles.begin(), phaseCycles.end(), uint64_t(0)));
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase)
+        printLine(report, std::string("  ") + PHASE_NAMES[phase], phaseCycles[phase]);
+    return report.str();
+}
+
+std::string LexerStatistics::toJson() const
+{
+    std::ostringstream report;
+    report << "{\"tokens\":" << getTokenCount() << ",\"tokensByType\":{";
+    const char *separator = "";
+    for (size_t type = 0; type < TOKEN_TYPE_COUNT; ++type)
+    {
+        if (tokenCounts[type] == 0)
+            continue;
+        report << separator << "\"" << TOKEN_TYPE_NAMES[type] << "\":" << tokenCounts[type];
+        separator = ",";
+    }
+    report << "},\"bytesConsumed\":" << bytesConsumed << ",\"sourceRefills\":" << sourceStatistics.refills
+           << ",\"sourceSystemCalls\":" << sourceStatistics.systemCalls << ",\"maxIndentDepth\":" << maxIndentDepth
+           << ",\"cycles\":{";
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase)
+        report << (phase ? "," : "") << "\"" << PHASE_NAMES[phase] << "\":" << phaseCycles[phase];
+    report << "}}\n";
+    return report.str();
+}
@@ -1,165 +1,500 @@
 #include "lexical_analyzer/lexicalAnalyzer.hpp"
 using namespace Operators;
 
+namespace
+{
+    struct Chunk
+    {
+        uint64_t offset;
+        std::unique_ptr<StringSource> source;
+        std::unique_ptr<LexicalAnalyzer> analyzer;
+        TokenStream stream;
+        std::exception_ptr error;
+    };
+
+    CompactToken makeToken(Token::TokenType type, uint64_t absolutePosition,
+                           Token::TokenSubtype subtype = Token::TokenSubtype::NoSubtype)
+    {
+        return CompactToken{type, subtype, CompactToken::PayloadKind::None, 0, static_cast<uint32_t>(absolutePosition), {}};
+    }
+
+    CompactToken makeToken(Token::TokenType type, uint64_t absolutePosition, int64_t integer)
+    {
+        CompactToken token = makeToken(type, absolutePosition);
+        token.payloadKind = CompactToken::PayloadKind::Integer;
+        token.integer = integer;
+        return token;
+    }
+
+    CompactToken makeToken(Token::TokenType type, uint64_t absolutePosition, double floating)
+    {
+        CompactToken token = makeToken(type, absolutePosition);
+        token.payloadKind = CompactToken::PayloadKind::Double;
+        token.floating = floating;
+        return token;
+    }
+
+    CompactToken makeToken(Token::TokenType type, uint64_t absolutePosition, CompactToken::PayloadKind payloadKind,
+                           uint32_t index)
+    {
+        CompactToken token = makeToken(type, absolutePosition);
+        token.payloadKind = payloadKind;
+        token.index = index;
+        return token;
+    }
+}
+
 std::optional<Token> LexicalAnalyzer::getToken()
 {
-    std::optional<Token> nextToken = buildEOF();
-    if (nextToken)
-        return nextToken;
-    if (!isNextLine)
-        skipWhites();
-    else
+    std::optional<CompactToken> token = lexToken();
+    if (!token)
+        return {};
+    return expand(*token, tokenPosition);
+}
+
+std::optional<CompactToken> LexicalAnalyzer::getCompactToken()
+{
+    std::optional<CompactToken> token = lexToken();
+    if (token)
+        compactPosition(tokenPosition);
+    return token;
+}
+
+std::optional<CompactToken> LexicalAnalyzer::lexToken()
+{
+    using LexicalTable::CharacterClass;
+    NextCharacter current = source.getCurrentCharacter();
+    tokenPosition = current.absolutePosition;
+    if (isNextLine && current.nextLetter != '\0')
     {
-        nextToken = buildIndent();
         isNextLine = false;
-        if (nextToken)
-            return nextToken;
+        std::optional<CompactToken> indentToken =
+            INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Indentation, buildIndent(current));
+        if (indentToken)
+            return indentToken;
+        current = source.getCurrentCharacter();
+        tokenPosition = current.absolutePosition;
+    }
+    if (LexicalTable::classify(current.nextLetter) == CharacterClass::Space)
+    {
+        INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Whitespace, skipWhites());
+        current = source.getCurrentCharacter();
+        tokenPosition = current.absolutePosition;
     }
 
-    nextToken = buildStringLiteral();
-    if (nextToken)
-        return nextToken;
+    switch (LexicalTable::classify(current.nextLetter))
+    {
+    case CharacterClass::EndOfFile:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Other, buildEOF(current));
+    case CharacterClass::Letter:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Identifiers, buildIdentifierOrKeyword(current));
+    case CharacterClass::Digit:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Numbers, buildNumber(current));
+    case CharacterClass::Quote:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Strings, buildStringLiteral(current));
+    case CharacterClass::Hash:
+        if (commentMode == CommentMode::Keep)
+            return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Comments, buildComment(current));
+        INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Comments, skipComment(current));
+        return lexToken();
+    case CharacterClass::Slash:
+    {
+        std::optional<CompactToken> token =
+            INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Operators, buildDivisionTokenOrComment(current));
+        return token ? token : lexToken();
+    }
+    case CharacterClass::NewLine:
+    case CharacterClass::Operator:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Operators, buildOneCharToken(current));
+    case CharacterClass::Relational:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Operators, buildLogicalOperatorToken(current));
+    default:
+        return INSTRUMENT_PHASE(statistics, LexerStatistics::Phase::Other, buildUnindentified(current));
+    }
+}
 
-    nextToken = buildNumber();
-    if (nextToken)
-        return nextToken;
+#ifdef TKOM_INSTRUMENTATION
+LexerStatistics LexicalAnalyzer::getStatistics() const
+{
+    LexerStatistics report = statistics;
+    report.setSourceStatistics(source.getCurrentCharacter().absolutePosition, source.getStatistics());
+    return report;
+}
+#endif
 
-    nextToken = buildIdentifierOrKeyword();
-    if (nextToken)
-        return nextToken;
+CompactToken LexicalAnalyzer::reportError(Diagnostic::Kind kind, NextCharacter &current)
+{
+    Diagnostic diagnostic{kind, current.absolutePosition};
+    if (errorMode == ErrorMode::Throw)
+        throwError(diagnostic);
+    diagnostics.push_back(diagnostic);
+    NextCharacter nextCharacter = source.getCurrentCharacter();
+    if (!buffer.empty())
+    {
+        uint64_t end = Scanner::findLineEnd(buffer, nextCharacter.absolutePosition);
+        if (end != nextCharacter.absolutePosition)
+            source.seek(end);
+    }
+    else
+    {
+        while (nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != '\0')
+            nextCharacter = source.getChar();
+    }
+    return makeToken(Token::TokenType::ErrorToken, current.absolutePosition);
+}
 
-    nextToken = buildComment();
-    if (nextToken)
-        return nextToken;
+void LexicalAnalyzer::throwError(const Diagnostic &diagnostic) const
+{
+    std::string message = describe(diagnostic);
+    switch (diagnostic.kind)
+    {
+    case Diagnostic::Kind::CommentTooLong:
+    case Diagnostic::Kind::StringLiteralTooLong:
+        throw TooLongStringLiteral(message.c_str());
+    case Diagnostic::Kind::MalformedStringLiteral:
+        throw WronglyDefinedStringLiteral(message.c_str());
+    case Diagnostic::Kind::MalformedExponent:
+    case Diagnostic::Kind::MalformedHexLiteral:
+        throw WronglyDefinedNumberLiteral(message.c_str());
+    case Diagnostic::Kind::IntegerTooBig:
+    case Diagnostic::Kind::DoubleOutOfRange:
+        throw IntegerTooBig(message.c_str());
+    default:
+        throw NotConsistentIndent(message.c_str());
+    }
+}
 
-    nextToken = buildDivisionTokenOrComment();
-    if (nextToken)
-        return nextToken;
+std::string LexicalAnalyzer::describe(const Diagnostic &diagnostic) const
+{
+    std::string position = source.getLinePosition(diagnostic.absolutePosition);
+    switch (diagnostic.kind)
+    {
+    case Diagnostic::Kind::CommentTooLong:
+        return "Commentary at " + position + " is too long.";
+    case Diagnostic::Kind::StringLiteralTooLong:
+        return "String literal at " + position + " is too long.";
+    case Diagnostic::Kind::MalformedStringLiteral:
+        return "String literal at " + position + " is malformed.";
+    case Diagnostic::Kind::MalformedExponent:
+        return "Exponent of double constant at " + position + " is malformed.";
+    case Diagnostic::Kind::MalformedHexLiteral:
+        return "Hexadecimal constant at " + position + " is malformed.";
+    case Diagnostic::Kind::IntegerTooBig:
+        return "Integer constant at " + position + " is too big!";
+    case Diagnostic::Kind::DoubleOutOfRange:
+        return "Double constant at " + position + " is out of range!";
+    case Diagnostic::Kind::InconsistentIndentCharacters:
+        return "Inconsistent use of tabs and spaces in indentation at " + position;
+    default:
+        return "Inconsistent indentation at " + position;
+    }
+}
 
-    nextToken = buildOneCharToken();
-    if (nextToken)
-        return nextToken;
+TokenStream LexicalAnalyzer::tokenizeAll()
+{
+    TokenStream stream;
+    tokenizeAll(stream);
+    return stream;
+}
 
-    nextToken = buildLogicalOperatorToken();
-    if (nextToken)
-        return nextToken;
+void LexicalAnalyzer::tokenizeAll(TokenStream &stream)
+{
+    stream.clear();
+    stream.reserve(TokenStream::estimateTokenCount(source.getSizeHint()));
+    stream.setTables(tables);
+    std::optional<CompactToken> token;
+    do
+    {
+        token = getCompactToken();
+        stream.push(*token);
+    } while (token->type != Token::TokenType::EndOfFileToken);
+}
 
-    return buildUnindentified();
+void LexicalAnalyzer::tokenizeAllParallel(TokenStream &stream, uint32_t threadCount, size_t chunkSize)
+{
+    if (buffer.empty() || threadCount < 2 || buffer.size() <= chunkSize)
+    {
+        tokenizeAll(stream);
+        return;
+    }
+    std::vector<Chunk> chunks;
+    for (size_t start = 0; start < buffer.size();)
+    {
+        size_t end = buffer.find('\n', std::min(start + chunkSize, buffer.size()) - 1);
+        end = end == std::string_view::npos ? buffer.size() : end + 1;
+        chunks.push_back(Chunk{start, std::make_unique<StringSource>(buffer.substr(start, end - start)), nullptr, {}, nullptr});
+        start = end;
+    }
+    std::atomic<size_t> nextChunk = 0;
+    auto lexChunks = [&] {
+        for (size_t index = nextChunk++; index < chunks.size(); index = nextChunk++)
+        {
+            Chunk &chunk = chunks[index];
+            try
+            {
+                chunk.analyzer = std::make_unique<LexicalAnalyzer>(*chunk.source, commentMode, ErrorMode::Collect);
+                chunk.analyzer->deferIndentation = true;
+                chunk.analyzer->tokenizeAll(chunk.stream);
+            }
+            catch (...)
+            {
+                chunk.error = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < std::min<size_t>(threadCount, chunks.size()); ++i)
+        workers.emplace_back(lexChunks);
+    lexChunks();
+    for (std::thread &worker : workers)
+        worker.join();
+
+    stream.clear();
+    stream.reserve(TokenStream::estimateTokenCount(buffer.size()));
+    stream.setTables(tables);
+    for (size_t index = 0; index < chunks.size(); ++index)
+    {
+        Chunk &chunk = chunks[index];
+        if (chunk.error)
+            std::rethrow_exception(chunk.error);
+        stitchChunk(*chunk.analyzer, chunk.stream, chunk.offset, index + 1 == chunks.size(), stream);
+    }
+    if (source.getCurrentCharacter().absolutePosition < buffer.size())
+        source.seek(buffer.size());
 }
 
-std::optional<Token> LexicalAnalyzer::buildIdentifierOrKeyword()
+void LexicalAnalyzer::stitchChunk(const LexicalAnalyzer &chunkAnalyzer, const TokenStream &chunkStream,
+                                  uint64_t offset, bool isLast, TokenStream &stream)
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (isalpha(current.nextLetter))
+    std::vector<uint32_t> symbols(chunkAnalyzer.tables->symbolTable.size(), UINT32_MAX);
+    size_t marker = 0;
+    size_t diagnostic = 0;
+    bool skippingLine = false;
+    for (size_t index = 0; index < chunkStream.size(); ++index)
     {
-        std::stringstream ss;
-        ss << current.nextLetter;
-        NextCharacter nextCharacter = source.getChar();
-        while (isalnum(nextCharacter.nextLetter) || nextCharacter.nextLetter == '_')
+        CompactToken token = chunkStream[index];
+        if (token.type == Token::TokenType::EndOfFileToken && !isLast)
+            break;
+        uint64_t absolutePosition = offset + token.absolutePosition;
+        for (; marker < chunkAnalyzer.indentMarkers.size() &&
+               chunkAnalyzer.indentMarkers[marker].absolutePosition <= token.absolutePosition;
+             ++marker)
         {
-            ss << nextCharacter.nextLetter;
-            nextCharacter = source.getChar();
+            const IndentMarker &indentMarker = chunkAnalyzer.indentMarkers[marker];
+            uint64_t markerPosition = compactPosition(offset + indentMarker.absolutePosition);
+            Token::TokenType blockType = Token::TokenType::OpenBlockToken;
+            Diagnostic::Kind kind = Diagnostic::Kind::InconsistentIndent;
+            switch (changeIndent(indentMarker.letter, indentMarker.length))
+            {
+            case IndentChange::None:
+                continue;
+            case IndentChange::Close:
+                blockType = Token::TokenType::CloseBlockToken;
+                [[fallthrough]];
+            case IndentChange::Open:
+                stream.push(makeToken(blockType, markerPosition, CompactToken::PayloadKind::Text,
+                                      tables->indentTable.intern(indentStack.top()).id));
+                continue;
+            case IndentChange::InconsistentCharacters:
+                kind = Diagnostic::Kind::InconsistentIndentCharacters;
+                break;
+            default:
+                break;
+            }
+            Diagnostic indentDiagnostic{kind, markerPosition};
+            if (errorMode == ErrorMode::Throw)
+                throwError(indentDiagnostic);
+            diagnostics.push_back(indentDiagnostic);
+            stream.push(makeToken(Token::TokenType::ErrorToken, markerPosition));
+            skippingLine = true;
         }
-        auto type = LexicalTable::keywordTable.find(ss.str());
-        if (type != LexicalTable::keywordTable.end())
-            return Token(type->second, TokenVariant(ss.str()),
-                        current);
-        else
-            return Token(Token::TokenType::IdentifierToken, TokenVariant(ss.str()),
-                        current);
+        if (token.type == Token::TokenType::NextLineToken)
+        {
+            skippingLine = false;
+            if (source.getCurrentCharacter().absolutePosition < absolutePosition)
+                source.seek(absolutePosition);
+        }
+        if (token.type == Token::TokenType::ErrorToken)
+        {
+            Diagnostic chunkDiagnostic = chunkAnalyzer.diagnostics[diagnostic++];
+            chunkDiagnostic.absolutePosition += offset;
+            if (skippingLine)
+                continue;
+            if (errorMode == ErrorMode::Throw)
+            {
+                if (source.getCurrentCharacter().absolutePosition < absolutePosition)
+                    source.seek(absolutePosition);
+                throwError(chunkDiagnostic);
+            }
+            diagnostics.push_back(chunkDiagnostic);
+        }
+        if (skippingLine)
+            continue;
+        token.absolutePosition = compactPosition(absolutePosition);
+        if (token.payloadKind == CompactToken::PayloadKind::Symbol)
+        {
+            if (symbols[token.index] == UINT32_MAX)
+                symbols[token.index] =
+                    tables->symbolTable.internView(chunkAnalyzer.tables->symbolTable.getText(token.index)).id;
+            token.index = symbols[token.index];
+        }
+        stream.push(token);
     }
-    return {};
 }
 
-std::optional<Token> LexicalAnalyzer::buildEOF()
+uint32_t LexicalAnalyzer::compactPosition(uint64_t absolutePosition) const
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (current.nextLetter == '\0')
+    if (absolutePosition > UINT32_MAX)
     {
-        return Token(Token::TokenType::EndOfFileToken, std::monostate{},
-                     current);
+        std::string message = "Token at " + source.getLinePosition(absolutePosition) + " is beyond the compact token range.";
+        throw SourceTooLargeException(message.c_str());
     }
-    return {};
+    return absolutePosition;
 }
 
-std::optional<Token> LexicalAnalyzer::buildComment()
+Token LexicalAnalyzer::expand(const CompactToken &token) const
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (current.nextLetter == '#')
+    return expand(token, token.absolutePosition);
+}
+
+Token LexicalAnalyzer::expand(const CompactToken &token, uint64_t absolutePosition) const
+{
+    return tables->expand(token, absolutePosition);
+}
+
+CompactToken LexicalAnalyzer::buildIdentifierOrKeyword(NextCharacter &current)
+{
+    if (!buffer.empty())
     {
-        std::stringstream ss;
-        ss << current.nextLetter;
-        uint32_t length = 1;
         NextCharacter nextCharacter = source.getChar();
-        while (length <= MAXSIZE && nextCharacter.nextLetter != '\n' &&
-               nextCharacter.nextLetter != '\0')
-        {
-            ss << nextCharacter.nextLetter;
+        while (LexicalTable::isIdentifierCharacter(nextCharacter.nextLetter))
             nextCharacter = source.getChar();
-            ++length;
-        }
-        if (length >= MAXSIZE)
+        std::string_view text = buffer.substr(current.absolutePosition,
+                                              nextCharacter.absolutePosition - current.absolutePosition);
+        auto type = LexicalTable::findKeyword(text);
+        if (type)
+            return makeToken(*type, current.absolutePosition);
+        return makeToken(Token::TokenType::IdentifierToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.internView(text).id);
+    }
+    lexeme.clear();
+    lexeme.push_back(current.nextLetter);
+    NextCharacter nextCharacter = source.getChar();
+    while (LexicalTable::isIdentifierCharacter(nextCharacter.nextLetter))
+    {
+        lexeme.push_back(nextCharacter.nextLetter);
+        nextCharacter = source.getChar();
+    }
+    auto type = LexicalTable::findKeyword(lexeme);
+    if (type)
+        return makeToken(*type, current.absolutePosition);
+    else
+        return makeToken(Token::TokenType::IdentifierToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.intern(lexeme).id);
+}
+
+CompactToken LexicalAnalyzer::buildEOF(NextCharacter &current)
+{
+    return makeToken(Token::TokenType::EndOfFileToken, current.absolutePosition);
+}
+
+CompactToken LexicalAnalyzer::buildComment(NextCharacter &current)
+{
+    if (!buffer.empty())
+    {
+        uint64_t end = Scanner::findLineEnd(buffer, current.absolutePosition + 1);
+        if (end - current.absolutePosition >= MAXSIZE)
         {
-            char message[100];
-            sprintf(message, "Commentary at  at %s is too long.", current.getLinePosition().c_str());
-            throw TooLongStringLiteral(message);
+            return reportError(Diagnostic::Kind::CommentTooLong, current);
         }
-        return Token(Token::TokenType::CommentToken, TokenVariant(ss.str()),
-                     current);
+        source.seek(end);
+        return makeToken(Token::TokenType::CommentToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.internView(buffer.substr(current.absolutePosition, end - current.absolutePosition)).id);
     }
-    return {};
+    lexeme.clear();
+    lexeme.push_back(current.nextLetter);
+    uint32_t length = 1;
+    NextCharacter nextCharacter = source.getChar();
+    while (length <= MAXSIZE && nextCharacter.nextLetter != '\n' &&
+           nextCharacter.nextLetter != '\0')
+    {
+        lexeme.push_back(nextCharacter.nextLetter);
+        nextCharacter = source.getChar();
+        ++length;
+    }
+    if (length >= MAXSIZE)
+    {
+        return reportError(Diagnostic::Kind::CommentTooLong, current);
+    }
+    return makeToken(Token::TokenType::CommentToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                     tables->symbolTable.intern(lexeme).id);
 }
 
-std::optional<Token> LexicalAnalyzer::buildUnindentified()
+void LexicalAnalyzer::skipComment(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
-    return Token(Token::TokenType::UnindentifiedToken, std::monostate{},
-                 current);
+    if (!buffer.empty())
+    {
+        source.seek(Scanner::findLineEnd(buffer, current.absolutePosition + 1));
+        return;
+    }
+    NextCharacter nextCharacter = source.getChar();
+    while (nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != '\0')
+        nextCharacter = source.getChar();
 }
 
-std::optional<Token> LexicalAnalyzer::buildDivisionTokenOrComment()
+CompactToken LexicalAnalyzer::buildUnindentified(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (current.nextLetter == '/')
+    source.getChar();
+    return makeToken(Token::TokenType::UnindentifiedToken, current.absolutePosition);
+}
+
+std::optional<CompactToken> LexicalAnalyzer::buildDivisionTokenOrComment(NextCharacter &current)
+{
+    NextCharacter nextCharacter = source.getChar();
+    if (nextCharacter.nextLetter == '/' && commentMode == CommentMode::Discard)
     {
-        std::stringstream ss;
-        ss << current.nextLetter;
-        NextCharacter nextCharacter = source.getChar();
-        if (current.nextLetter == '/')
+        skipComment(nextCharacter);
+        return {};
+    }
+    else if (nextCharacter.nextLetter == '/' && !buffer.empty())
+    {
+        uint64_t end = Scanner::findLineEnd(buffer, nextCharacter.absolutePosition + 1);
+        if (end - current.absolutePosition >= MAXSIZE)
         {
-            ss << nextCharacter.nextLetter;
+            return reportError(Diagnostic::Kind::CommentTooLong, current);
+        }
+        source.seek(end);
+        return makeToken(Token::TokenType::CommentToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.internView(buffer.substr(current.absolutePosition, end - current.absolutePosition)).id);
+    }
+    else if (nextCharacter.nextLetter == '/')
+    {
+        lexeme.assign("//");
+        nextCharacter = source.getChar();
+        uint32_t length = 2;
+        while (length < MAXSIZE &&
+               nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != '\0')
+        {
+            lexeme.push_back(nextCharacter.nextLetter);
             nextCharacter = source.getChar();
-            uint32_t length = 2;
-            while (length < MAXSIZE &&
-                   nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != '\0')
-            {
-                ss << nextCharacter.nextLetter;
-                nextCharacter = source.getChar();
-                ++length;
-            }
-            if (length >= MAXSIZE)
-            {
-                char message[100];
-                sprintf(message, "Commentary at  at %s is too long.", current.getLinePosition().c_str());
-                throw TooLongStringLiteral(message);
-            }
-
-            return Token(Token::TokenType::CommentToken, TokenVariant(ss.str()),
-                         current);
+            ++length;
         }
-        else
+        if (length >= MAXSIZE)
         {
-            return Token(Token::TokenType::MultiplicativeOperatorToken,
-                         Token::TokenSubtype::DivisionToken, std::monostate{},
-                         current);
+            return reportError(Diagnostic::Kind::CommentTooLong, current);
         }
+
+        return makeToken(Token::TokenType::CommentToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.intern(lexeme).id);
+    }
+    else
+    {
+        return makeToken(Token::TokenType::MultiplicativeOperatorToken, current.absolutePosition, Token::TokenSubtype::DivisionToken);
     }
-    return {};
 }
 
-std::optional<Token> LexicalAnalyzer::buildOneCharToken()
+CompactToken LexicalAnalyzer::buildOneCharToken(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
     std::optional<Token::TokenType> type;
     std::optional<Token::TokenSubtype> subtype;
     switch (current.nextLetter)
@@ -177,6 +512,11 @@ std::optional<Token> LexicalAnalyzer::buildOneCharToken()
         subtype = Token::TokenSubtype::MinusToken;
         break;
 
+    case ('*'):
+        type = Token::TokenType::MultiplicativeOperatorToken;
+        subtype = Token::TokenSubtype::MultiplicationToken;
+        break;
+
     case ('('):
         type = Token::TokenType::OpenRoundBracketToken;
         break;
@@ -206,292 +546,266 @@ std::optional<Token> LexicalAnalyzer::buildOneCharToken()
         break;
     }
 
+    source.getChar();
     if (subtype)
+        return makeToken(*type, current.absolutePosition, *subtype);
+    return makeToken(*type, current.absolutePosition);
+}
+
+CompactToken LexicalAnalyzer::buildStringLiteral(NextCharacter &current)
+{
+    char delimiter = current.nextLetter;
+    if (!buffer.empty())
     {
-        source.getChar();
-        return Token(*type, *subtype, std::monostate{},
-                     current);
+        uint64_t end = Scanner::findStringEnd(buffer, current.absolutePosition + 1, delimiter);
+        if (end - current.absolutePosition >= MAXSIZE)
+        {
+            return reportError(Diagnostic::Kind::StringLiteralTooLong, current);
+        }
+        if (end == buffer.size() || buffer[end] != delimiter)
+        {
+            return reportError(Diagnostic::Kind::MalformedStringLiteral, current);
+        }
+        source.seek(end + 1);
+        return makeToken(Token::TokenType::StringLiteralToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.internView(buffer.substr(current.absolutePosition + 1, end - current.absolutePosition - 1)).id);
+    }
+    lexeme.clear();
+    NextCharacter nextCharacter = source.getChar();
+    uint32_t length = 1;
+    while (length < MAXSIZE && isprint(static_cast<unsigned char>(nextCharacter.nextLetter)) && nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != delimiter && nextCharacter.nextLetter != '\0')
+    {
+        lexeme.push_back(nextCharacter.nextLetter);
+        nextCharacter = source.getChar();
+        length++;
+    }
+    if (length >= MAXSIZE)
+    {
+        return reportError(Diagnostic::Kind::StringLiteralTooLong, current);
     }
-    else if (type)
+    else if (nextCharacter.nextLetter == delimiter)
     {
         source.getChar();
-        return Token(*type, std::monostate{},
-                     current);
+        return makeToken(Token::TokenType::StringLiteralToken, current.absolutePosition, CompactToken::PayloadKind::Symbol,
+                         tables->symbolTable.intern(lexeme).id);
+    }
+    else
+    {
+        return reportError(Diagnostic::Kind::MalformedStringLiteral, current);
     }
-    return {};
 }
 
-std::optional<Token> LexicalAnalyzer::buildStringLiteral()
+CompactToken LexicalAnalyzer::buildNumber(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (current.nextLetter == '\'' || current.nextLetter == '\"')
+    NextCharacter nextCharacter = source.getChar();
+    if (current.nextLetter == '0' && (nextCharacter.nextLetter == 'x' || nextCharacter.nextLetter == 'X'))
+        return buildHexInteger(current);
+    lexeme.clear();
+    lexeme.push_back(current.nextLetter);
+    int64_t integer = current.nextLetter - '0';
+    bool fits = true;
+    while (LexicalTable::isDigit(nextCharacter.nextLetter))
     {
-        char delimiter = current.nextLetter;
-        std::stringstream ss;
-        NextCharacter nextCharacter = source.getChar();
-        uint32_t length = 1;
-        while (length < MAXSIZE && isprint(nextCharacter.nextLetter) && nextCharacter.nextLetter != '\n' && nextCharacter.nextLetter != delimiter && nextCharacter.nextLetter != '\0')
+        fits = fits && !__builtin_mul_overflow(integer, 10, &integer) &&
+               !__builtin_add_overflow(integer, nextCharacter.nextLetter - '0', &integer);
+        lexeme.push_back(nextCharacter.nextLetter);
+        nextCharacter = source.getChar();
+    }
+    bool isDouble = false;
+    if (nextCharacter.nextLetter == '.')
+    {
+        isDouble = true;
+        lexeme.push_back('.');
+        nextCharacter = appendDigits(source.getChar());
+    }
+    if (nextCharacter.nextLetter == 'e' || nextCharacter.nextLetter == 'E')
+    {
+        isDouble = true;
+        lexeme.push_back('e');
+        nextCharacter = source.getChar();
+        if (nextCharacter.nextLetter == '+' || nextCharacter.nextLetter == '-')
         {
-            ss << nextCharacter.nextLetter;
+            lexeme.push_back(nextCharacter.nextLetter);
             nextCharacter = source.getChar();
-            length++;
         }
-        if (length >= MAXSIZE)
+        if (!LexicalTable::isDigit(nextCharacter.nextLetter))
         {
-            char message[100];
-            sprintf(message, "String literal at %s is too long.", current.getLinePosition().c_str());
-            throw TooLongStringLiteral(message);
-        }
-        else if (nextCharacter.nextLetter == delimiter)
-        {
-            source.getChar();
-            return Token(Token::TokenType::StringLiteralToken,
-                         TokenVariant(ss.str()),
-                        current);
-        }
-        else
-        {
-            char message[150];
-            sprintf(message, "String literal at %s is malformed.", current.getLinePosition().c_str());
-            throw WronglyDefinedStringLiteral(message);
+            return reportError(Diagnostic::Kind::MalformedExponent, current);
         }
+        appendDigits(nextCharacter);
     }
-    return {};
-}
-
-std::optional<Token> LexicalAnalyzer::buildNumber()
-{
-    NextCharacter current = source.getCurrentCharacter();
-    if (isdigit(current.nextLetter))
+    if (!isDouble)
     {
-        int64_t integerToBe = buildInteger(current);
-        NextCharacter nextCharacter = source.getCurrentCharacter();
-        if (nextCharacter.nextLetter == '.')
+        if (!fits)
         {
-            return Token(Token::TokenType::DoubleLiteralToken,
-                         TokenVariant(buildFloatingPointNumber(current, integerToBe)),
-                         current);
+            return reportError(Diagnostic::Kind::IntegerTooBig, current);
         }
-        else
-            return Token(Token::TokenType::IntegerLiteralToken,
-                         TokenVariant(integerToBe), current);
+        return makeToken(Token::TokenType::IntegerLiteralToken, current.absolutePosition, integer);
     }
-    return {};
-}
-
-bool LexicalAnalyzer::checkIfFits(const std::string_view numberToCheck,
-                                const std::string_view limit) const
-{
-    if (numberToCheck.length() > limit.length())
-        return false;
-    if (numberToCheck.length() == limit.length())
+    double value;
+    auto result = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+    if (result.ec == std::errc::result_out_of_range)
     {
-        for (long unsigned int i = 0; i < limit.length(); i++)
-        {
-            if (numberToCheck[i] > limit[i])
-                return false;
-        }
+        return reportError(Diagnostic::Kind::DoubleOutOfRange, current);
     }
-
-    return true;
+    return makeToken(Token::TokenType::DoubleLiteralToken, current.absolutePosition, value);
 }
 
-int64_t LexicalAnalyzer::buildInteger(NextCharacter &current)
+CompactToken LexicalAnalyzer::buildHexInteger(NextCharacter &current)
 {
-    int64_t integerToBe = current.nextLetter - '0';
-    uint64_t base = 10;
     NextCharacter nextCharacter = source.getChar();
-    while (isdigit(nextCharacter.nextLetter))
+    if (LexicalTable::hexDigitValue(nextCharacter.nextLetter) < 0)
     {
-        if (!checkIfFits(std::to_string(integerToBe) + nextCharacter.nextLetter,
-                         std::to_string(INT64_MAX)))
-        {
-            char message[150];
-            sprintf(message, "Integer constant at %s is too big!", current.getLinePosition().c_str());
-            throw IntegerTooBig(message);
-        }
-        integerToBe *= base;
-        integerToBe += nextCharacter.nextLetter - '0';
+        return reportError(Diagnostic::Kind::MalformedHexLiteral, current);
+    }
+    int64_t integer = 0;
+    bool fits = true;
+    for (int digit = LexicalTable::hexDigitValue(nextCharacter.nextLetter); digit >= 0;
+         digit = LexicalTable::hexDigitValue(nextCharacter.nextLetter))
+    {
+        fits = fits && !__builtin_mul_overflow(integer, 16, &integer) &&
+               !__builtin_add_overflow(integer, digit, &integer);
         nextCharacter = source.getChar();
     }
-    return integerToBe;
+    if (!fits)
+    {
+        return reportError(Diagnostic::Kind::IntegerTooBig, current);
+    }
+    return makeToken(Token::TokenType::IntegerLiteralToken, current.absolutePosition, integer);
 }
-double LexicalAnalyzer::buildFloatingPointNumber(NextCharacter &current, int64_t integerPart)
+
+NextCharacter LexicalAnalyzer::appendDigits(NextCharacter nextCharacter)
 {
-    if (!checkIfFits(std::to_string(integerPart), std::to_string(std::numeric_limits<double>::max())))
-        {
-            char message[150];
-            sprintf(message, "Double constant at %s is too big!", current.getLinePosition().c_str());
-            throw IntegerTooBig(message);
-        }
-    double finalFractionalpart = 0;
-    short base = 10;
-    NextCharacter nextCharacter = source.getChar();
-    if (isdigit(nextCharacter.nextLetter))
+    while (LexicalTable::isDigit(nextCharacter.nextLetter))
     {
-        int64_t fractionalPart = 0;
-        fractionalPart = nextCharacter.nextLetter - '0';
-        uint32_t length = 1;
+        lexeme.push_back(nextCharacter.nextLetter);
         nextCharacter = source.getChar();
-        while (isdigit(nextCharacter.nextLetter))
-        {
-            fractionalPart *= base;
-            fractionalPart += nextCharacter.nextLetter - '0';
-            ++length;
-            nextCharacter = source.getChar();
-        }
-        finalFractionalpart = fractionalPart / pow(base, length);
     }
-    return integerPart + finalFractionalpart;
+    return nextCharacter;
 }
 
-std::optional<Token> LexicalAnalyzer::buildLogicalOperatorToken()
+CompactToken LexicalAnalyzer::buildLogicalOperatorToken(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
+    NextCharacter nextCharacter = source.getChar();
     switch (current.nextLetter)
     {
     case ('<'):
     {
-        NextCharacter nextCharacter = source.getChar();
         if (nextCharacter.nextLetter == '=')
         {
             source.getChar();
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::LessOrEqualToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::LessOrEqualToken);
         }
         else
         {
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::LessToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::LessToken);
         }
         break;
     }
 
     case ('>'):
     {
-        NextCharacter nextCharacter = source.getChar();
         if (nextCharacter.nextLetter == '=')
         {
             source.getChar();
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::GreaterOrEqualToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::GreaterOrEqualToken);
         }
         else
         {
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::GreaterToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::GreaterToken);
         }
         break;
     }
 
     case ('='):
     {
-        NextCharacter nextCharacter = source.getChar();
         if (nextCharacter.nextLetter == '=')
         {
             source.getChar();
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::EqualToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::EqualToken);
         }
         else
         {
-            return Token(Token::TokenType::AssignmentOperatorToken,
-                         std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::AssignmentOperatorToken, current.absolutePosition);
         }
         break;
     }
 
-    case ('!'):
+    default:
     {
-        NextCharacter nextCharacter = source.getChar();
         if (nextCharacter.nextLetter == '=')
         {
             source.getChar();
-            return Token(Token::TokenType::LogicalOperatorToken,
-                         Token::TokenSubtype::NotEqualToken, std::monostate{},
-                         current);
+            return makeToken(Token::TokenType::LogicalOperatorToken, current.absolutePosition, Token::TokenSubtype::NotEqualToken);
         }
         else
         {
-            return Token(Token::TokenType::NotToken,
-                         std::monostate{}, current);
+            return makeToken(Token::TokenType::NotToken, current.absolutePosition);
         }
-        break;
     }
     }
-    return {};
 }
 
 void LexicalAnalyzer::skipWhites()
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (isspace(current.nextLetter) && current.nextLetter != '\n')
+    if (!buffer.empty())
     {
-        NextCharacter nextCharacter = source.getChar();
-        while (isspace(nextCharacter.nextLetter) && current.nextLetter != '\n')
-        {
-            nextCharacter = source.getChar();
-        }
+        source.seek(Scanner::findNonSpace(buffer, source.getCurrentCharacter().absolutePosition + 1));
+        return;
+    }
+    NextCharacter nextCharacter = source.getChar();
+    while (LexicalTable::classify(nextCharacter.nextLetter) == LexicalTable::CharacterClass::Space)
+    {
+        nextCharacter = source.getChar();
     }
 }
 
-std::optional<Token> LexicalAnalyzer::buildIndent()
+std::optional<CompactToken> LexicalAnalyzer::buildIndent(NextCharacter &current)
 {
-    NextCharacter current = source.getCurrentCharacter();
-    if (current.nextLetter == ' ' || current.nextLetter == '\t')
+    if (current.nextLetter != ' ' && current.nextLetter != '\t')
+        return {};
+    uint32_t length = 1;
+    while (source.getChar().nextLetter == current.nextLetter)
+        ++length;
+    if (deferIndentation)
     {
-        if (chosenIndentChar == 0)
-        {
-            chosenIndentChar = current.nextLetter;
-        }
-        else if (current.nextLetter != chosenIndentChar)
-        {
-            std::string messsage = "Inconsistent use of tabs and spaces in indentation at " +
-                                   current.getLinePosition();
-            throw NotConsistentIndent(messsage.c_str());
-        }
-        std::stringstream ss;
-        ss << current.nextLetter;
-        NextCharacter nextCharacter = source.getChar();
-        while (nextCharacter.nextLetter == chosenIndentChar)
-        {
-            ss << nextCharacter.nextLetter;
-            nextCharacter = source.getChar();
-        }
-        auto indentString = ss.str();
-        if (indentStack.top() != indentString)
-        {
-            if (indentStack.top().length() < indentString.length())
-            {
-                indentStack.push(indentString);
-                return Token(Token::TokenType::OpenBlockToken, TokenVariant(indentString),
-                             current);
-            }
-            else
-            {
-                while (indentStack.top().length() > indentString.length())
-                {
-                    indentStack.pop();
-                }
-                if (indentStack.top().length() == indentString.length())
-                {
-                    return Token(Token::TokenType::CloseBlockToken, TokenVariant(indentString),
-                                 current);
-                }
-                else
-                {
-                    std::string messsage = "Inconsistent indentation at " +
-                                           current.getLinePosition();
-                    throw NotConsistentIndent(messsage.c_str());
-                }
-            }
-        }
+        indentMarkers.push_back(IndentMarker{current.absolutePosition, length, current.nextLetter});
+        return {};
+    }
+    switch (changeIndent(current.nextLetter, length))
+    {
+    case IndentChange::Open:
+        return makeToken(Token::TokenType::OpenBlockToken, current.absolutePosition, CompactToken::PayloadKind::Text,
+                         tables->indentTable.intern(indentStack.top()).id);
+    case IndentChange::Close:
+        return makeToken(Token::TokenType::CloseBlockToken, current.absolutePosition, CompactToken::PayloadKind::Text,
+                         tables->indentTable.intern(indentStack.top()).id);
+    case IndentChange::InconsistentCharacters:
+        return reportError(Diagnostic::Kind::InconsistentIndentCharacters, current);
+    case IndentChange::Inconsistent:
+        return reportError(Diagnostic::Kind::InconsistentIndent, current);
+    default:
+        return {};
+    }
+}
+
+LexicalAnalyzer::IndentChange LexicalAnalyzer::changeIndent(char letter, uint32_t length)
+{
+    if (chosenIndentChar == 0)
+        chosenIndentChar = letter;
+    else if (letter != chosenIndentChar)
+        return IndentChange::InconsistentCharacters;
+    if (indentStack.top().length() == length)
+        return IndentChange::None;
+    if (indentStack.top().length() < length)
+    {
+        indentStack.push(std::string(length, letter));
+        INSTRUMENT(statistics.recordIndentDepth(indentStack.size() - 1));
+        return IndentChange::Open;
     }
-    return {};
+    while (indentStack.top().length() > length)
+        indentStack.pop();
+    if (indentStack.top().length() == length)
+        return IndentChange::Close;
+    return IndentChange::Inconsistent;
 }
@@ -0,0 +1,151 @@
+#include "lexical_analyzer/scanner.hpp"
+#include "lexical_analyzer/lexicalTable.hpp"
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    struct NonSpace
+    {
+        static bool scalar(unsigned char letter, char)
+        {
+            return LexicalTable::classify(letter) != LexicalTable::CharacterClass::Space;
+        }
+#if defined(__SSE2__)
+        static __m128i sse2(__m128i block, __m128i)
+        {
+            __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+            __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+            __m128i space = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), control),
+                                         _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')));
+            return _mm_xor_si128(space, _mm_set1_epi8(-1));
+        }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i block, __m256i)
+        {
+            __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+            __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8('\r' - '\t')), shifted);
+            __m256i space = _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')), control),
+                                            _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')));
+            return _mm256_xor_si256(space, _mm256_set1_epi8(-1));
+        }
+#endif
+    };
+
+    struct LineEnd
+    {
+        static bool scalar(unsigned char letter, char)
+        {
+            return letter == '\n' || letter == '\0';
+        }
+#if defined(__SSE2__)
+        static __m128i sse2(__m128i block, __m128i)
+        {
+            return _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')),
+                                _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+        }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i block, __m256i)
+        {
+            return _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')),
+                                   _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+        }
+#endif
+    };
+
+    struct StringEnd
+    {
+        static bool scalar(unsigned char letter, char delimiter)
+        {
+            return letter == static_cast<unsigned char>(delimiter) || letter < 0x20 || letter > 0x7e;
+        }
+#if defined(__SSE2__)
+        static __m128i sse2(__m128i block, __m128i delimiter)
+        {
+            __m128i unprintable = _mm_or_si128(_mm_cmplt_epi8(block, _mm_set1_epi8(0x20)),
+                                               _mm_cmpeq_epi8(block, _mm_set1_epi8(0x7f)));
+            return _mm_or_si128(unprintable, _mm_cmpeq_epi8(block, delimiter));
+        }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i block, __m256i delimiter)
+        {
+            __m256i unprintable = _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), block),
+                                                  _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x7f)));
+            return _mm256_or_si256(unprintable, _mm256_cmpeq_epi8(block, delimiter));
+        }
+#endif
+    };
+
+    template <class Predicate>
+    size_t scanScalar(std::string_view text, size_t from, char delimiter)
+    {
+        while (from < text.size() && !Predicate::scalar(text[from], delimiter))
+            ++from;
+        return from;
+    }
+
+#if defined(__SSE2__)
+    template <class Predicate>
+    size_t scanSse2(std::string_view text, size_t from, char delimiter)
+    {
+        const __m128i delimiters = _mm_set1_epi8(delimiter);
+        for (; from + 16 <= text.size(); from += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + from));
+            uint32_t mask = _mm_movemask_epi8(Predicate::sse2(block, delimiters));
+            if (mask)
+                return from + __builtin_ctz(mask);
+        }
+        return scanScalar<Predicate>(text, from, delimiter);
+    }
+
+    template <class Predicate>
+    __attribute__((target("avx2"))) size_t scanAvx2(std::string_view text, size_t from, char delimiter)
+    {
+        const __m256i delimiters = _mm256_set1_epi8(delimiter);
+        for (; from + 32 <= text.size(); from += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text.data() + from));
+            uint32_t mask = _mm256_movemask_epi8(Predicate::avx2(block, delimiters));
+            if (mask)
+                return from + __builtin_ctz(mask);
+        }
+        return scanSse2<Predicate>(text, from, delimiter);
+    }
+#endif
+
+    template <class Predicate>
+    size_t scan(std::string_view text, size_t from, char delimiter, Scanner::Kernel kernel)
+    {
+#if defined(__SSE2__)
+        if (kernel == Scanner::Kernel::AVX2)
+            return scanAvx2<Predicate>(text, from, delimiter);
+        if (kernel == Scanner::Kernel::SSE2)
+            return scanSse2<Predicate>(text, from, delimiter);
+#endif
+        return scanScalar<Predicate>(text, from, delimiter);
+    }
+}
+
+Scanner::Kernel Scanner::bestKernel()
+{
+#if defined(__SSE2__)
+    static const Kernel kernel = __builtin_cpu_supports("avx2") ? Kernel::AVX2 : Kernel::SSE2;
+    return kernel;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+size_t Scanner::findNonSpace(std::string_view text, size_t from, Kernel kernel)
+{
+    return scan<NonSpace>(text, from, 0, kernel);
+}
+
+size_t Scanner::findLineEnd(std::string_view text, size_t from, Kernel kernel)
+{
+    return scan<LineEnd>(text, from, 0, kernel);
+}
+
+size_t Scanner::findStringEnd(std::string_view text, size_t from, char delimiter, Kernel kernel)
+{
+    return scan<StringEnd>(text, from, delimiter, kernel);
+}
@@ -0,0 +1,44 @@
+#include "lexical_analyzer/symbolTable.hpp"
+#include <functional>
+
+Symbol SymbolTable::intern(const std::string_view text)
+{
+    uint32_t &slot = findSlot(text);
+    if (slot != EMPTY_SLOT)
+        return Symbol{slot, symbols[slot]};
+    return insert(slot, storage.emplace_back(text));
+}
+
+Symbol SymbolTable::internView(const std::string_view text)
+{
+    uint32_t &slot = findSlot(text);
+    if (slot != EMPTY_SLOT)
+        return Symbol{slot, symbols[slot]};
+    return insert(slot, text);
+}
+
+uint32_t &SymbolTable::findSlot(const std::string_view text)
+{
+    size_t mask = slots.size() - 1;
+    size_t index = std::hash<std::string_view>{}(text) & mask;
+    while (slots[index] != EMPTY_SLOT && symbols[slots[index]] != text)
+        index = (index + 1) & mask;
+    return slots[index];
+}
+
+Symbol SymbolTable::insert(uint32_t &slot, const std::string_view text)
+{
+    uint32_t id = symbols.size();
+    symbols.push_back(text);
+    slot = id;
+    if (symbols.size() * 2 > slots.size())
+        grow();
+    return Symbol{id, text};
+}
+
+void SymbolTable::grow()
+{
+    slots.assign(slots.size() * 2, EMPTY_SLOT);
+    for (uint32_t id = 0; id < symbols.size(); ++id)
+        findSlot(symbols[id]) = id;
+}
@@ -0,0 +1,273 @@
+#include "lexical_analyzer/tokenCache.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include "helpers/hash.hpp"
+
+namespace
+{
+    const char MAGIC[8] = {'T', 'K', 'O', 'M', 'T', 'O', 'K', 'S'};
+
+    struct CacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint8_t commentMode;
+        uint8_t reserved[3];
+        uint64_t sourceHash;
+        uint64_t sourceSize;
+        uint64_t tokenCount;
+        uint64_t symbolCount;
+        uint64_t textSize;
+        uint64_t indentCount;
+    };
+
+    bool hasEntrySize(const CacheHeader &header, uint64_t mappingSize)
+    {
+        uint64_t size = sizeof(CacheHeader);
+        uint64_t tokenColumns, textCount, symbolColumn;
+        return !__builtin_mul_overflow(header.tokenCount, sizeof(uint64_t) + sizeof(uint32_t) + 3, &tokenColumns) &&
+               !__builtin_add_overflow(header.symbolCount, header.indentCount, &textCount) &&
+               !__builtin_mul_overflow(textCount, sizeof(uint64_t), &symbolColumn) &&
+               !__builtin_add_overflow(size, tokenColumns, &size) &&
+               !__builtin_add_overflow(size, symbolColumn, &size) &&
+               !__builtin_add_overflow(size, header.textSize, &size) && size == mappingSize;
+    }
+
+    template <class T>
+    void writeColumn(std::ofstream &entry, const T *data, size_t count)
+    {
+        entry.write(reinterpret_cast<const char *>(data), count * sizeof(T));
+    }
+}
+
+CachedTokenStream::CachedTokenStream(const char *mapping, size_t mappingSize)
+    : mapping(mapping), mappingSize(mappingSize)
+{
+    const CacheHeader *header = reinterpret_cast<const CacheHeader *>(mapping);
+    const char *position = mapping + sizeof(CacheHeader);
+    auto column = [&](auto *&data, size_t count) {
+        data = reinterpret_cast<std::remove_reference_t<decltype(data)>>(position);
+        position += count * sizeof(*data);
+    };
+    const uint64_t *payloadData;
+    const uint64_t *symbolEndData;
+    const uint32_t *offsetData;
+    const Token::TokenType *typeData;
+    const Token::TokenSubtype *subtypeData;
+    const CompactToken::PayloadKind *payloadKindData;
+    column(payloadData, header->tokenCount);
+    column(symbolEndData, header->symbolCount + header->indentCount);
+    column(offsetData, header->tokenCount);
+    column(typeData, header->tokenCount);
+    column(subtypeData, header->tokenCount);
+    column(payloadKindData, header->tokenCount);
+    payloads = {payloadData, header->tokenCount};
+    symbolEnds = {symbolEndData, header->symbolCount};
+    indentEnds = {symbolEndData + header->symbolCount, header->indentCount};
+    offsets = {offsetData, header->tokenCount};
+    types = {typeData, header->tokenCount};
+    subtypes = {subtypeData, header->tokenCount};
+    payloadKinds = {payloadKindData, header->tokenCount};
+    text = position;
+}
+
+CachedTokenStream::~CachedTokenStream()
+{
+    munmap(const_cast<char *>(mapping), mappingSize);
+}
+
+bool CachedTokenStream::hasValidSymbols(uint64_t textSize) const
+{
+    uint64_t previousEnd = 0;
+    for (std::span<const uint64_t> ends : {symbolEnds, indentEnds})
+    {
+        for (uint64_t end : ends)
+        {
+            if (end < previousEnd || end > textSize)
+                return false;
+            previousEnd = end;
+        }
+    }
+    for (size_t index = 0; index < payloads.size(); ++index)
+    {
+        if ((payloadKinds[index] == CompactToken::PayloadKind::Symbol && payloads[index] >= symbolEnds.size()) ||
+            (payloadKinds[index] == CompactToken::PayloadKind::Text && payloads[index] >= indentEnds.size()))
+            return false;
+    }
+    return true;
+}
+
+CompactToken CachedTokenStream::operator[](size_t index) const
+{
+    CompactToken token{types[index], subtypes[index], payloadKinds[index], 0, offsets[index], {}};
+    token.setPayloadBits(payloads[index]);
+    return token;
+}
+
+// Symbol texts are followed by indent texts in one blob, so both index the ends column together.
+std::string_view CachedTokenStream::getEntryText(uint64_t entry) const
+{
+    const uint64_t *ends = symbolEnds.data();
+    uint64_t start = entry == 0 ? 0 : ends[entry - 1];
+    return std::string_view(text + start, ends[entry] - start);
+}
+
+std::string_view CachedTokenStream::getText(uint64_t id) const
+{
+    return getEntryText(id);
+}
+
+std::string_view CachedTokenStream::getIndent(uint64_t id) const
+{
+    return getEntryText(symbolEnds.size() + id);
+}
+
+Token CachedTokenStream::expand(const CompactToken &token) const
+{
+    switch (token.payloadKind)
+    {
+    case CompactToken::PayloadKind::Integer:
+        return Token(token.type, token.subtype, token.integer, token.absolutePosition);
+    case CompactToken::PayloadKind::Double:
+        return Token(token.type, token.subtype, token.floating, token.absolutePosition);
+    case CompactToken::PayloadKind::Symbol:
+        return Token(token.type, token.subtype, Symbol{static_cast<uint32_t>(token.index), getText(token.index)},
+                     token.absolutePosition);
+    case CompactToken::PayloadKind::Text:
+        return Token(token.type, token.subtype, std::string(getIndent(token.index)), token.absolutePosition);
+    default:
+        return Token(token.type, token.subtype, std::monostate{}, token.absolutePosition);
+    }
+}
+
+TokenCache::TokenCache(const std::filesystem::path &directory, LexicalAnalyzer::CommentMode commentMode)
+    : directory(directory), commentMode(commentMode)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+        throw TokenCacheException(("Cannot create token cache directory " + directory.string()).c_str());
+}
+
+CachedTokenStreamUptr TokenCache::load(std::string_view source) const
+{
+    return load(source, Hash::xxHash64(source));
+}
+
+void TokenCache::store(std::string_view source, const TokenStream &stream, const TokenTables &tables) const
+{
+    store(source, Hash::xxHash64(source), stream, tables);
+}
+
+CachedTokenStreamUptr TokenCache::tokenize(std::string_view source) const
+{
+    uint64_t sourceHash = Hash::xxHash64(source);
+    CachedTokenStreamUptr cached = load(source, sourceHash);
+    if (cached)
+        return cached;
+    StringSource stringSource(source);
+    LexicalAnalyzer lexicalAnalyzer(stringSource, commentMode);
+    TokenStream stream;
+    lexicalAnalyzer.tokenizeAllParallel(stream);
+    store(source, sourceHash, stream, *stream.getTables());
+    cached = load(source, sourceHash);
+    if (!cached)
+        throw TokenCacheException(("Cannot read back token cache entry " + entryPath(sourceHash).string()).c_str());
+    return cached;
+}
+
+std::filesystem::path TokenCache::getEntryPath(std::string_view source) const
+{
+    return entryPath(Hash::xxHash64(source));
+}
+
+std::filesystem::path TokenCache::entryPath(uint64_t sourceHash) const
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-v%u-%c.tokens", static_cast<unsigned long long>(sourceHash),
+             LexicalAnalyzer::VERSION, commentMode == LexicalAnalyzer::CommentMode::Keep ? 'k' : 'd');
+    return directory / name;
+}
+
+CachedTokenStreamUptr TokenCache::load(std::string_view source, uint64_t sourceHash) const
+{
+    int descriptor = ::open(entryPath(sourceHash).c_str(), O_RDONLY);
+    if (descriptor == -1)
+        return nullptr;
+    struct stat fileStatus;
+    if (fstat(descriptor, &fileStatus) == -1 || static_cast<size_t>(fileStatus.st_size) < sizeof(CacheHeader))
+    {
+        ::close(descriptor);
+        return nullptr;
+    }
+    size_t mappingSize = fileStatus.st_size;
+    void *address = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED)
+        return nullptr;
+    const CacheHeader *header = static_cast<const CacheHeader *>(address);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != LexicalAnalyzer::VERSION ||
+        header->commentMode != static_cast<uint8_t>(commentMode) || header->sourceHash != sourceHash ||
+        header->sourceSize != source.size() || header->tokenCount > mappingSize ||
+        header->symbolCount > mappingSize || header->textSize > mappingSize || header->indentCount > mappingSize ||
+        !hasEntrySize(*header, mappingSize))
+    {
+        munmap(address, mappingSize);
+        return nullptr;
+    }
+    CachedTokenStreamUptr cached(new CachedTokenStream(static_cast<const char *>(address), mappingSize));
+    if (!cached->hasValidSymbols(header->textSize))
+        return nullptr;
+    return cached;
+}
+
+void TokenCache::store(std::string_view source, uint64_t sourceHash, const TokenStream &stream,
+                       const TokenTables &tables) const
+{
+    CacheHeader header{{}, LexicalAnalyzer::VERSION, static_cast<uint8_t>(commentMode), {}, sourceHash,
+                       source.size(), stream.size(), tables.symbolTable.size(), 0, tables.indentTable.size()};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    std::vector<uint64_t> symbolEnds;
+    symbolEnds.reserve(tables.symbolTable.size() + tables.indentTable.size());
+    for (const SymbolTable *table : {&tables.symbolTable, &tables.indentTable})
+    {
+        for (uint32_t id = 0; id < table->size(); ++id)
+        {
+            header.textSize += table->getText(id).size();
+            symbolEnds.push_back(header.textSize);
+        }
+    }
+
+    std::filesystem::path path = entryPath(sourceHash);
+    std::filesystem::path temporaryPath = path.string() + ".tmp" + std::to_string(getpid());
+    std::ofstream entry(temporaryPath, std::ios::binary | std::ios::trunc);
+    writeColumn(entry, &header, 1);
+    writeColumn(entry, stream.getPayloads().data(), stream.size());
+    writeColumn(entry, symbolEnds.data(), symbolEnds.size());
+    writeColumn(entry, stream.getOffsets().data(), stream.size());
+    writeColumn(entry, stream.getTypes().data(), stream.size());
+    writeColumn(entry, stream.getSubtypes().data(), stream.size());
+    writeColumn(entry, stream.getPayloadKinds().data(), stream.size());
+    for (const SymbolTable *table : {&tables.symbolTable, &tables.indentTable})
+    {
+        for (uint32_t id = 0; id < table->size(); ++id)
+            entry.write(table->getText(id).data(), table->getText(id).size());
+    }
+    entry.close();
+    std::error_code error;
+    if (entry.fail())
+    {
+        std::filesystem::remove(temporaryPath, error);
+        throw TokenCacheException(("Cannot write token cache entry " + path.string()).c_str());
+    }
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        throw TokenCacheException(("Cannot write token cache entry " + path.string()).c_str());
+    }
+}
@@ -0,0 +1,43 @@
+#include "lexical_analyzer/tokenGenerator.hpp"
+
+std::optional<Token> TokenGenerator::next()
+{
+    if (done())
+        return std::nullopt;
+    handle.resume();
+    if (handle.promise().exception)
+        std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+    return std::exchange(handle.promise().token, std::nullopt);
+}
+
+TokenGenerator TokenFeed::lex(FeedSource &source, LexicalAnalyzer::CommentMode commentMode,
+                              LexicalAnalyzer::ErrorMode errorMode)
+{
+    while (!source.hasCompleteLine())
+        co_await std::suspend_always{};
+    LexicalAnalyzer lexicalAnalyzer(source, commentMode, errorMode);
+    for (;;)
+    {
+        while (!source.hasCompleteLine())
+            co_await std::suspend_always{};
+        Token token = *lexicalAnalyzer.getToken();
+        bool endOfFile = token.getType() == Token::TokenType::EndOfFileToken;
+        co_yield std::move(token);
+        if (endOfFile)
+            co_return;
+    }
+}
+
+TokenGenerator generateTokens(SourceBase &source, LexicalAnalyzer::CommentMode commentMode,
+                              LexicalAnalyzer::ErrorMode errorMode)
+{
+    LexicalAnalyzer lexicalAnalyzer(source, commentMode, errorMode);
+    for (;;)
+    {
+        Token token = *lexicalAnalyzer.getToken();
+        bool endOfFile = token.getType() == Token::TokenType::EndOfFileToken;
+        co_yield std::move(token);
+        if (endOfFile)
+            co_return;
+    }
+}
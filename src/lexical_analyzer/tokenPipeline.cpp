@@ -0,0 +1,84 @@
+#include "lexical_analyzer/tokenPipeline.hpp"
+
+TokenPipeline::TokenPipeline(SourceBase &source, LexicalAnalyzer::CommentMode commentMode,
+                             LexicalAnalyzer::ErrorMode errorMode, size_t batchSize)
+    : lexicalAnalyzer(source, commentMode, errorMode), batchSize(std::max<size_t>(batchSize, 1))
+{
+    producer = std::thread([this] { produce(); });
+}
+
+TokenPipeline::~TokenPipeline()
+{
+    stopping = true;
+    Batch batch;
+    while (batches.tryPop(batch))
+        ;
+    producer.join();
+}
+
+std::optional<Token> TokenPipeline::getToken()
+{
+    if (endOfFile)
+        return endOfFile;
+    while (position == current.tokens.size())
+        nextBatch();
+    Token &token = current.tokens[position++];
+    if (token.getType() == Token::TokenType::EndOfFileToken)
+    {
+        endOfFile = std::move(token);
+        return endOfFile;
+    }
+    return std::move(token);
+}
+
+void TokenPipeline::nextBatch()
+{
+    if (error)
+        std::rethrow_exception(error);
+    current.tokens.clear();
+    freeBatches.tryPush(current);
+    while (!batches.tryPop(current))
+        batches.waitWhileEmpty();
+    position = 0;
+    if (current.error)
+    {
+        error = current.error;
+        std::rethrow_exception(error);
+    }
+}
+
+void TokenPipeline::produce()
+{
+    Batch batch;
+    try
+    {
+        for (bool endOfFile = false; !endOfFile && !stopping.load(std::memory_order_relaxed);)
+        {
+            if (!freeBatches.tryPop(batch))
+                batch = Batch{};
+            batch.tokens.reserve(batchSize);
+            while (batch.tokens.size() < batchSize && !endOfFile)
+            {
+                batch.tokens.push_back(*lexicalAnalyzer.getToken());
+                endOfFile = batch.tokens.back().getType() == Token::TokenType::EndOfFileToken;
+            }
+            publish(batch);
+        }
+    }
+    catch (...)
+    {
+        publish(batch);
+        Batch failure{{}, std::current_exception()};
+        publish(failure);
+    }
+}
+
+void TokenPipeline::publish(Batch &batch)
+{
+    while (!batches.tryPush(batch))
+    {
+        if (stopping.load(std::memory_order_relaxed))
+            return;
+        batches.waitWhileFull();
+    }
+}
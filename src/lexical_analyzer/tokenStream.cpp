@@ -0,0 +1,91 @@
+#include "lexical_analyzer/tokenStream.hpp"
+#include "helpers/exception.hpp"
+#include "helpers/replaceRange.hpp"
+using namespace Containers;
+
+void TokenStream::reserve(size_t tokenCount)
+{
+    types.reserve(tokenCount);
+    subtypes.reserve(tokenCount);
+    offsets.reserve(tokenCount);
+    payloadKinds.reserve(tokenCount);
+    payloads.reserve(tokenCount);
+}
+
+void TokenStream::push(const CompactToken &token)
+{
+    types.push_back(token.type);
+    subtypes.push_back(token.subtype);
+    offsets.push_back(token.absolutePosition);
+    payloadKinds.push_back(token.payloadKind);
+    payloads.push_back(token.getPayloadBits());
+}
+
+void TokenStream::clear()
+{
+    types.clear();
+    subtypes.clear();
+    offsets.clear();
+    payloadKinds.clear();
+    payloads.clear();
+    tables.reset();
+}
+
+void TokenStream::splice(size_t first, size_t last, const TokenStream &replacement, int64_t offsetDelta)
+{
+    if (offsetDelta != 0)
+    {
+        for (size_t index = last; index < offsets.size(); ++index)
+            offsets[index] += offsetDelta;
+    }
+    replaceRange(types, first, last, replacement.types);
+    replaceRange(subtypes, first, last, replacement.subtypes);
+    replaceRange(offsets, first, last, replacement.offsets);
+    replaceRange(payloadKinds, first, last, replacement.payloadKinds);
+    replaceRange(payloads, first, last, replacement.payloads);
+}
+
+// Rewrites the Symbol payloads after their table has been rebuilt with new ids.
+void TokenStream::remapSymbols(const std::vector<uint32_t> &symbolIds)
+{
+    for (size_t index = 0; index < payloads.size(); ++index)
+    {
+        if (payloadKinds[index] == CompactToken::PayloadKind::Symbol)
+            payloads[index] = symbolIds[payloads[index]];
+    }
+}
+
+CompactToken TokenStream::operator[](size_t index) const
+{
+    CompactToken token{types[index], subtypes[index], payloadKinds[index], 0, offsets[index], {}};
+    token.setPayloadBits(payloads[index]);
+    return token;
+}
+
+Token TokenStream::expand(size_t index) const
+{
+    if (!tables)
+        throw TokenStreamException("Token stream is not attached to the tables of the analyzer that filled it.");
+    return tables->expand((*this)[index], offsets[index]);
+}
+
+Token TokenTables::expand(const CompactToken &token, uint64_t absolutePosition) const
+{
+    switch (token.payloadKind)
+    {
+    case CompactToken::PayloadKind::Integer:
+        return Token(token.type, token.subtype, token.integer, absolutePosition);
+    case CompactToken::PayloadKind::Double:
+        return Token(token.type, token.subtype, token.floating, absolutePosition);
+    case CompactToken::PayloadKind::Symbol:
+        return Token(token.type, token.subtype,
+                     Symbol{static_cast<uint32_t>(token.index), symbolTable.getText(token.index)},
+                     absolutePosition);
+    case CompactToken::PayloadKind::Text:
+        return Token(token.type, token.subtype, std::string(indentTable.getText(token.index)), absolutePosition);
+    case CompactToken::PayloadKind::Matrix:
+        return Token(token.type, token.subtype, matrices[token.index], absolutePosition);
+    default:
+        return Token(token.type, token.subtype, std::monostate{}, absolutePosition);
+    }
+}
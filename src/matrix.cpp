@@ -0,0 +1,126 @@
+#include "matrix.hpp"
+#include "matrixKernels.hpp"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+static_assert(sizeof(int64_t) == sizeof(double), "Matrix elements share one storage size");
+
+Matrix::Matrix(uint32_t rows, uint32_t columns, ElementType elementType)
+    : rows(rows), columns(columns), elementType(elementType)
+{
+    allocate();
+    if (storage)
+        memset(storage.get(), 0, size() * sizeof(int64_t));
+}
+
+Matrix::Matrix(uint32_t rows, uint32_t columns, std::initializer_list<double> values)
+    : rows(checkValueCount(rows, columns, values.size())), columns(columns), elementType(ElementType::Double)
+{
+    allocate();
+    std::copy(values.begin(), values.end(), elements<double>());
+}
+
+Matrix::Matrix(const Matrix &other) : rows(other.rows), columns(other.columns), elementType(other.elementType)
+{
+    allocate();
+    if (storage)
+        memcpy(storage.get(), other.storage.get(), size() * sizeof(int64_t));
+}
+
+Matrix::Matrix(Matrix &&other) noexcept
+    : rows(std::exchange(other.rows, 0)), columns(std::exchange(other.columns, 0)), elementType(other.elementType),
+      storage(std::move(other.storage))
+{
+}
+
+Matrix &Matrix::operator=(const Matrix &other)
+{
+    if (this != &other)
+        *this = Matrix(other);
+    return *this;
+}
+
+Matrix &Matrix::operator=(Matrix &&other) noexcept
+{
+    rows = std::exchange(other.rows, 0);
+    columns = std::exchange(other.columns, 0);
+    elementType = other.elementType;
+    storage = std::move(other.storage);
+    return *this;
+}
+
+uint32_t Matrix::checkValueCount(uint32_t rows, uint32_t columns, size_t count)
+{
+    if (count != static_cast<size_t>(rows) * columns)
+        throw MatrixDimensionMismatch("Number of matrix values does not match its dimensions.");
+    return rows;
+}
+
+void Matrix::allocate()
+{
+    if (size() > SIZE_MAX / sizeof(int64_t))
+        throw MatrixTooLarge("Matrix dimensions exceed the addressable storage size.");
+    if (size() > 0)
+        storage.reset(static_cast<std::byte *>(::operator new(size() * sizeof(int64_t), std::align_val_t(ALIGNMENT))));
+}
+
+Matrix Matrix::emptyLike() const
+{
+    Matrix result;
+    result.rows = rows;
+    result.columns = columns;
+    result.elementType = elementType;
+    result.allocate();
+    return result;
+}
+
+Matrix &Matrix::operator+=(const Matrix &other)
+{
+    add(*this, other, *this);
+    return *this;
+}
+
+Matrix &Matrix::operator-=(const Matrix &other)
+{
+    subtract(*this, other, *this);
+    return *this;
+}
+
+void Matrix::add(const Matrix &lhs, const Matrix &rhs, Matrix &result)
+{
+    if (lhs.rows != rhs.rows || lhs.columns != rhs.columns)
+        throw MatrixDimensionMismatch("Added matrices have different dimensions.");
+    if (lhs.elementType == ElementType::Integer)
+        MatrixKernels::add<int64_t>(lhs.getValues<int64_t>(), rhs.getValues<int64_t>(), result.getValues<int64_t>());
+    else
+        MatrixKernels::add<double>(lhs.getValues<double>(), rhs.getValues<double>(), result.getValues<double>());
+}
+
+void Matrix::subtract(const Matrix &lhs, const Matrix &rhs, Matrix &result)
+{
+    if (lhs.rows != rhs.rows || lhs.columns != rhs.columns)
+        throw MatrixDimensionMismatch("Subtracted matrices have different dimensions.");
+    if (lhs.elementType == ElementType::Integer)
+        MatrixKernels::subtract<int64_t>(lhs.getValues<int64_t>(), rhs.getValues<int64_t>(), result.getValues<int64_t>());
+    else
+        MatrixKernels::subtract<double>(lhs.getValues<double>(), rhs.getValues<double>(), result.getValues<double>());
+}
+
+void Matrix::scaleIntegers(const Matrix &matrix, int64_t factor, bool divide, Matrix &result)
+{
+    if (!divide)
+        MatrixKernels::multiply<int64_t>(matrix.getValues<int64_t>(), factor, result.getValues<int64_t>());
+    else if (factor == 0)
+        throw MatrixDivisionByZero("Integer matrix cannot be divided by zero.");
+    else
+        MatrixKernels::divide<int64_t>(matrix.getValues<int64_t>(), factor, result.getValues<int64_t>());
+}
+
+void Matrix::scaleDoubles(const Matrix &matrix, double factor, bool divide, Matrix &result)
+{
+    if (divide)
+        MatrixKernels::divide<double>(matrix.getValues<double>(), factor, result.getValues<double>());
+    else
+        MatrixKernels::multiply<double>(matrix.getValues<double>(), factor, result.getValues<double>());
+}
@@ -0,0 +1,208 @@
+#include "matrixKernels.hpp"
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Integer arithmetic wraps around in every kernel, the way the vector instructions do.
+    int64_t wrap(uint64_t value)
+    {
+        return static_cast<int64_t>(value);
+    }
+
+#if defined(__SSE2__)
+    template <class T>
+    struct Lanes;
+
+    template <>
+    struct Lanes<int64_t>
+    {
+        static __m128i loadSse2(const int64_t *values) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(values)); }
+        static void storeSse2(int64_t *values, __m128i lanes) { _mm_storeu_si128(reinterpret_cast<__m128i *>(values), lanes); }
+        static __m128i broadcastSse2(int64_t value) { return _mm_set1_epi64x(value); }
+        __attribute__((target("avx2"))) static __m256i loadAvx2(const int64_t *values)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+        }
+        __attribute__((target("avx2"))) static void storeAvx2(int64_t *values, __m256i lanes)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(values), lanes);
+        }
+        __attribute__((target("avx2"))) static __m256i broadcastAvx2(int64_t value) { return _mm256_set1_epi64x(value); }
+    };
+
+    template <>
+    struct Lanes<double>
+    {
+        static __m128d loadSse2(const double *values) { return _mm_loadu_pd(values); }
+        static void storeSse2(double *values, __m128d lanes) { _mm_storeu_pd(values, lanes); }
+        static __m128d broadcastSse2(double value) { return _mm_set1_pd(value); }
+        __attribute__((target("avx2"))) static __m256d loadAvx2(const double *values) { return _mm256_loadu_pd(values); }
+        __attribute__((target("avx2"))) static void storeAvx2(double *values, __m256d lanes)
+        {
+            _mm256_storeu_pd(values, lanes);
+        }
+        __attribute__((target("avx2"))) static __m256d broadcastAvx2(double value) { return _mm256_set1_pd(value); }
+    };
+#endif
+
+    struct Add
+    {
+        static int64_t scalar(int64_t lhs, int64_t rhs) { return wrap(static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs)); }
+        static double scalar(double lhs, double rhs) { return lhs + rhs; }
+#if defined(__SSE2__)
+        static __m128i sse2(__m128i lhs, __m128i rhs) { return _mm_add_epi64(lhs, rhs); }
+        static __m128d sse2(__m128d lhs, __m128d rhs) { return _mm_add_pd(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i lhs, __m256i rhs) { return _mm256_add_epi64(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256d avx2(__m256d lhs, __m256d rhs) { return _mm256_add_pd(lhs, rhs); }
+#endif
+    };
+
+    struct Subtract
+    {
+        static int64_t scalar(int64_t lhs, int64_t rhs) { return wrap(static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs)); }
+        static double scalar(double lhs, double rhs) { return lhs - rhs; }
+#if defined(__SSE2__)
+        static __m128i sse2(__m128i lhs, __m128i rhs) { return _mm_sub_epi64(lhs, rhs); }
+        static __m128d sse2(__m128d lhs, __m128d rhs) { return _mm_sub_pd(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i lhs, __m256i rhs) { return _mm256_sub_epi64(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256d avx2(__m256d lhs, __m256d rhs) { return _mm256_sub_pd(lhs, rhs); }
+#endif
+    };
+
+    struct Multiply
+    {
+        static int64_t scalar(int64_t lhs, int64_t rhs) { return wrap(static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs)); }
+        static double scalar(double lhs, double rhs) { return lhs * rhs; }
+#if defined(__SSE2__)
+        // Neither SSE2 nor AVX2 multiplies 64-bit lanes, so the low 64 bits are assembled from 32-bit products.
+        static __m128i sse2(__m128i lhs, __m128i rhs)
+        {
+            __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(lhs, 32), rhs),
+                                          _mm_mul_epu32(lhs, _mm_srli_epi64(rhs, 32)));
+            return _mm_add_epi64(_mm_mul_epu32(lhs, rhs), _mm_slli_epi64(cross, 32));
+        }
+        static __m128d sse2(__m128d lhs, __m128d rhs) { return _mm_mul_pd(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256i avx2(__m256i lhs, __m256i rhs)
+        {
+            __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(lhs, 32), rhs),
+                                             _mm256_mul_epu32(lhs, _mm256_srli_epi64(rhs, 32)));
+            return _mm256_add_epi64(_mm256_mul_epu32(lhs, rhs), _mm256_slli_epi64(cross, 32));
+        }
+        __attribute__((target("avx2"))) static __m256d avx2(__m256d lhs, __m256d rhs) { return _mm256_mul_pd(lhs, rhs); }
+#endif
+    };
+
+    struct Divide
+    {
+        static int64_t scalar(int64_t lhs, int64_t rhs)
+        {
+            return rhs == -1 ? wrap(0 - static_cast<uint64_t>(lhs)) : lhs / rhs;
+        }
+        static double scalar(double lhs, double rhs) { return lhs / rhs; }
+#if defined(__SSE2__)
+        static __m128d sse2(__m128d lhs, __m128d rhs) { return _mm_div_pd(lhs, rhs); }
+        __attribute__((target("avx2"))) static __m256d avx2(__m256d lhs, __m256d rhs) { return _mm256_div_pd(lhs, rhs); }
+#endif
+    };
+
+    // A zero rhsStep repeats rhs[0] for every element, which is how the scalar operations are applied.
+    template <class Operation, class T>
+    void applyScalar(const T *lhs, const T *rhs, size_t rhsStep, T *result, size_t from, size_t count)
+    {
+        for (; from < count; ++from)
+            result[from] = Operation::scalar(lhs[from], rhs[from * rhsStep]);
+    }
+
+#if defined(__SSE2__)
+    template <class Operation, class T>
+    void applySse2(const T *lhs, const T *rhs, size_t rhsStep, T *result, size_t from, size_t count)
+    {
+        const size_t width = 16 / sizeof(T);
+        const auto broadcast = Lanes<T>::broadcastSse2(rhsStep ? T() : *rhs);
+        for (; from + width <= count; from += width)
+        {
+            auto right = rhsStep ? Lanes<T>::loadSse2(rhs + from) : broadcast;
+            Lanes<T>::storeSse2(result + from, Operation::sse2(Lanes<T>::loadSse2(lhs + from), right));
+        }
+        applyScalar<Operation>(lhs, rhs, rhsStep, result, from, count);
+    }
+
+    template <class Operation, class T>
+    __attribute__((target("avx2"))) void applyAvx2(const T *lhs, const T *rhs, size_t rhsStep, T *result, size_t from,
+                                                   size_t count)
+    {
+        const size_t width = 32 / sizeof(T);
+        const auto broadcast = Lanes<T>::broadcastAvx2(rhsStep ? T() : *rhs);
+        for (; from + 2 * width <= count; from += 2 * width)
+        {
+            auto first = rhsStep ? Lanes<T>::loadAvx2(rhs + from) : broadcast;
+            auto second = rhsStep ? Lanes<T>::loadAvx2(rhs + from + width) : broadcast;
+            Lanes<T>::storeAvx2(result + from, Operation::avx2(Lanes<T>::loadAvx2(lhs + from), first));
+            Lanes<T>::storeAvx2(result + from + width, Operation::avx2(Lanes<T>::loadAvx2(lhs + from + width), second));
+        }
+        applySse2<Operation>(lhs, rhs, rhsStep, result, from, count);
+    }
+#endif
+
+    template <class Operation, class T>
+    void apply(const T *lhs, const T *rhs, size_t rhsStep, T *result, size_t count, MatrixKernels::Kernel kernel)
+    {
+#if defined(__SSE2__)
+        if (kernel == MatrixKernels::Kernel::AVX2)
+            return applyAvx2<Operation>(lhs, rhs, rhsStep, result, 0, count);
+        if (kernel == MatrixKernels::Kernel::SSE2)
+            return applySse2<Operation>(lhs, rhs, rhsStep, result, 0, count);
+#endif
+        applyScalar<Operation>(lhs, rhs, rhsStep, result, 0, count);
+    }
+}
+
+MatrixKernels::Kernel MatrixKernels::bestKernel()
+{
+#if defined(__SSE2__)
+    static const Kernel kernel = __builtin_cpu_supports("avx2") ? Kernel::AVX2 : Kernel::SSE2;
+    return kernel;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+template <class T>
+void MatrixKernels::add(std::span<const T> lhs, std::span<const T> rhs, std::span<T> result, Kernel kernel)
+{
+    apply<Add>(lhs.data(), rhs.data(), 1, result.data(), result.size(), kernel);
+}
+
+template <class T>
+void MatrixKernels::subtract(std::span<const T> lhs, std::span<const T> rhs, std::span<T> result, Kernel kernel)
+{
+    apply<Subtract>(lhs.data(), rhs.data(), 1, result.data(), result.size(), kernel);
+}
+
+template <class T>
+void MatrixKernels::multiply(std::span<const T> values, T factor, std::span<T> result, Kernel kernel)
+{
+    apply<Multiply>(values.data(), &factor, 0, result.data(), result.size(), kernel);
+}
+
+template <class T>
+void MatrixKernels::divide(std::span<const T> values, T divisor, std::span<T> result, Kernel kernel)
+{
+    // There is no vector integer division, so integer quotients always take the scalar loop.
+    if constexpr (std::is_same_v<T, int64_t>)
+        applyScalar<Divide>(values.data(), &divisor, 0, result.data(), 0, result.size());
+    else
+        apply<Divide>(values.data(), &divisor, 0, result.data(), result.size(), kernel);
+}
+
+template void MatrixKernels::add(std::span<const int64_t>, std::span<const int64_t>, std::span<int64_t>, Kernel);
+template void MatrixKernels::add(std::span<const double>, std::span<const double>, std::span<double>, Kernel);
+template void MatrixKernels::subtract(std::span<const int64_t>, std::span<const int64_t>, std::span<int64_t>, Kernel);
+template void MatrixKernels::subtract(std::span<const double>, std::span<const double>, std::span<double>, Kernel);
+template void MatrixKernels::multiply(std::span<const int64_t>, int64_t, std::span<int64_t>, Kernel);
+template void MatrixKernels::multiply(std::span<const double>, double, std::span<double>, Kernel);
+template void MatrixKernels::divide(std::span<const int64_t>, int64_t, std::span<int64_t>, Kernel);
+template void MatrixKernels::divide(std::span<const double>, double, std::span<double>, Kernel);
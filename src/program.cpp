@@ -2,6 +2,8 @@
 
 SourceSptr Program::source;
 LexicalAnalyzerUptr Program::lexicalAnalyzer;
+CachedTokenStreamUptr Program::cachedTokens;
+TokenPipelineUptr Program::tokenPipeline;
 
 void Program::start(const int argc, const std::vector<std::string_view> &arguments)
 {
@@ -24,10 +26,25 @@ void Program::parseFlags(const std::vector<std::string_view> &arguments)
         switch (option)
         {
         case (FlagResolver::Options::File):
+        case (FlagResolver::Options::MappedFile):
+        case (FlagResolver::Options::StreamedFile):
         case (FlagResolver::Options::Socket):
         case (FlagResolver::Options::String):
             source = SourceFactory::createSource(option, arguments);
-            Program::lexicalAnalyzer = std::make_unique<LexicalAnalyzer>(*source.get());
+            Program::lexicalAnalyzer = std::make_unique<LexicalAnalyzer>(*source.get(), LexicalAnalyzer::CommentMode::Discard);
+            break;
+        case (FlagResolver::Options::Pipeline):
+            source = SourceFactory::createSource(option, arguments);
+            Program::tokenPipeline = std::make_unique<TokenPipeline>(*source.get(), LexicalAnalyzer::CommentMode::Discard);
+            break;
+        case (FlagResolver::Options::CachedFile):
+            loadCachedTokens(arguments);
+            break;
+        case (FlagResolver::Options::Statistics):
+            printStatistics(arguments);
+            break;
+        case (FlagResolver::Options::Server):
+            startServer(arguments);
             break;
         case (FlagResolver::Options::Help):
             showHelp();
@@ -44,6 +61,66 @@ void Program::parseFlags(const std::vector<std::string_view> &arguments)
     }
 }
 
+void Program::startServer(const std::vector<std::string_view> &arguments)
+{
+    auto parseNumber = [&](size_t index, uint defaultValue) {
+        if (arguments.size() <= index)
+            return defaultValue;
+        uint value;
+        auto argument = arguments[index];
+        auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+        if (error != std::errc() || end != argument.data() + argument.size())
+            throw WrongFlagsException("Server port and worker count must be numbers. Try --help for help");
+        return value;
+    };
+    uint port = parseNumber(2, SocketWrapper::DEFAULT_PORT);
+    uint workerCount = parseNumber(3, std::thread::hardware_concurrency());
+    SocketServer server(port, workerCount, summarizeTokens);
+    std::cout << "Listening on port " << server.getPort() << " with " << server.getWorkerCount() << " workers" << std::endl;
+    server.run();
+}
+
+void Program::loadCachedTokens(const std::vector<std::string_view> &arguments)
+{
+    if (arguments.size() < 4)
+        throw WrongFlagsException("Cached lexing needs a source file and a cache directory. Try --help for help");
+    try
+    {
+        source = SourceFactory::createSource(FlagResolver::Options::CachedFile, arguments);
+        source->open();
+        TokenCache tokenCache(arguments[3], LexicalAnalyzer::CommentMode::Discard);
+        cachedTokens = tokenCache.tokenize(source->getBuffer());
+    }
+    catch (Exception &ex)
+    {
+        std::cout << ex.what() << "\n";
+    }
+}
+
+void Program::printStatistics([[maybe_unused]] const std::vector<std::string_view> &arguments)
+{
+#ifdef TKOM_INSTRUMENTATION
+    if (arguments.size() < 3 || (arguments.size() > 3 && arguments[3] != "text" && arguments[3] != "json"))
+        throw WrongFlagsException("Statistics need a source file and an optional text or json format. Try --help for help");
+    source = SourceFactory::createSource(FlagResolver::Options::File, arguments);
+    lexicalAnalyzer = std::make_unique<LexicalAnalyzer>(*source.get());
+    while (lexicalAnalyzer->getToken()->getType() != Token::TokenType::EndOfFileToken)
+        ;
+    LexerStatistics statistics = lexicalAnalyzer->getStatistics();
+    std::cout << (arguments.size() > 3 && arguments[3] == "json" ? statistics.toJson() : statistics.toText());
+#else
+    throw WrongFlagsException("Lexer statistics are not compiled in. Rebuild with -DINSTRUMENTATION=ON");
+#endif
+}
+
+std::string Program::summarizeTokens(LexicalAnalyzer &analyzer)
+{
+    uint64_t tokenCount = 0;
+    while (analyzer.getToken()->getType() != Token::TokenType::EndOfFileToken)
+        ++tokenCount;
+    return "OK " + std::to_string(tokenCount) + "\n";
+}
+
 void Program::showHelp()
 {
 
@@ -52,7 +129,15 @@ void Program::showHelp()
     std::cout << "*   --help/-h shows help                                          *\n";
     std::cout << "*   --string/-s <source string> parse code from string            *\n";
     std::cout << "*   --file/-f <path to source file> parse code from file          *\n";
+    std::cout << "*   --mmap/-m <path to source file> parse memory-mapped file      *\n";
+    std::cout << "*   --stream/-st <path to source file> parse file read ahead      *\n";
+    std::cout << "*   --cache/-c <path to source file> <cache directory>            *\n";
+    std::cout << "*              reuse tokens cached for unchanged files            *\n";
+    std::cout << "*   --stats/-sts <path to source file> [text|json]                *\n";
+    std::cout << "*              report lexer statistics (-DINSTRUMENTATION=ON)     *\n";
+    std::cout << "*   --pipeline/-p <path to source file> lex on a separate thread  *\n";
     std::cout << "*   --socket/-sc  <socket> parse code from socket                 *\n";
+    std::cout << "*   --server/-sv [port] [workers] serve many socket clients       *\n";
     std::cout << "*******************************************************************\n";
 }
 
@@ -1,10 +1,63 @@
 #include "source.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cerrno>
 
 void FileSource::open()
 {
     fileSource.open(filepath, std::fstream::in);
     currentCharacter = getChar();
 }
+void MappedFileSource::open()
+{
+    close();
+    int descriptor = ::open(filepath.c_str(), O_RDONLY);
+    if (descriptor == -1)
+        throw WrongFilepathException("Cannot open file!");
+    struct stat fileStatus;
+    if (fstat(descriptor, &fileStatus) == -1)
+    {
+        ::close(descriptor);
+        throw WrongFilepathException("Cannot read file status!");
+    }
+    mappingSize = fileStatus.st_size;
+    if (mappingSize > 0)
+    {
+        void *address = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED)
+        {
+            ::close(descriptor);
+            throw WrongFilepathException("Cannot map file into memory!");
+        }
+        madvise(address, mappingSize, MADV_SEQUENTIAL);
+        mapping = static_cast<const char *>(address);
+        INSTRUMENT(++statistics.refills; statistics.systemCalls += 2);
+    }
+    ::close(descriptor);
+    INSTRUMENT(statistics.systemCalls += 3);
+    rewind();
+    currentCharacter = getChar();
+}
+
+void ReadAheadFileSource::open()
+{
+    close();
+    descriptor = ::open(filepath.c_str(), O_RDONLY);
+    if (descriptor == -1)
+        throw WrongFilepathException("Cannot open file!");
+    posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+    produced = released = 0;
+    holdingBuffer = endOfFile = stopping = false;
+    readError = nullptr;
+    current = nullptr;
+    currentPosition = currentLength = 0;
+    readTime = stallTime = std::chrono::nanoseconds::zero();
+    rewind();
+    reader = std::thread([this] { readAhead(); });
+    currentCharacter = getChar();
+}
+
 void SocketSource::open()
 {
     socketSource = socketWrapper.getSocket();
@@ -16,10 +69,38 @@ void StringSource::open(){
     currentCharacter = getChar();
 }
 
+void FeedSource::open()
+{
+    currentCharacter = getChar();
+}
+
 void FileSource::close()
 {
     fileSource.close();
 }
+void MappedFileSource::close()
+{
+    if (mapping)
+        munmap(const_cast<char *>(mapping), mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+}
+void ReadAheadFileSource::close()
+{
+    if (reader.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            stopping = true;
+        }
+        buffersCondition.notify_all();
+        reader.join();
+    }
+    if (descriptor != -1)
+        ::close(descriptor);
+    descriptor = -1;
+}
+
 void SocketSource::close()
 {
     ::close(socketSource);
@@ -27,42 +108,192 @@ void SocketSource::close()
 
 NextCharacter StringSource::getChar()
 {
-    char letter = stringSource[position.getAbsolutePosition()];
-    currentCharacter = NextCharacter(letter, position.getAbsolutePosition(),
-                                     position.getChar(), position.getLine());
-    position = position.nextChar();
-    if (letter == '\n')
+    char letter = position < stringSource.size() ? stringSource[position] : '\0';
+    return emitChar(letter);
+}
+
+NextCharacter FeedSource::getChar()
+{
+    char letter = readPosition < pending.size() ? pending[readPosition++] : '\0';
+    return emitChar(letter);
+}
+
+void FeedSource::push(std::string_view data)
+{
+    if (finished)
+        throw FeedClosedException("Cannot push data into a finished feed.");
+    if (readPosition > COMPACTION_THRESHOLD && readPosition > pending.size() / 2)
     {
-        position = position.nextLine();
+        size_t discarded = readPosition - 1;
+        pending.erase(0, discarded);
+        readPosition -= discarded;
+        searchPosition -= std::min(searchPosition, discarded);
     }
-    return currentCharacter;
+    pending.append(data);
+}
+
+// The lexer reads one character past a line break, so a line is only complete once that character arrived.
+bool FeedSource::hasCompleteLine()
+{
+    if (finished)
+        return true;
+    searchPosition = std::max(searchPosition, readPosition == 0 ? 0 : readPosition - 1);
+    size_t lineEnd = pending.find('\n', searchPosition);
+    if (lineEnd == std::string::npos)
+    {
+        searchPosition = pending.size();
+        return false;
+    }
+    searchPosition = lineEnd;
+    return lineEnd + 1 < pending.size();
+}
+
+uint64_t FileSource::getSizeHint() const
+{
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(filepath, error);
+    return error ? 0 : size;
 }
 
 NextCharacter FileSource::getChar() 
 {
+    INSTRUMENT(if (fileSource.rdbuf()->in_avail() <= 0) { ++statistics.refills; ++statistics.systemCalls; });
     char letter = fileSource.get();
     if(fileSource.eof())
         letter = '\0';
-    currentCharacter = NextCharacter(letter, position.getAbsolutePosition(),
-                                     position.getChar(), position.getLine());
-    position = position.nextChar();
-    if (letter == '\n')
+    return emitChar(letter);
+}
+
+NextCharacter MappedFileSource::getChar()
+{
+    char letter = position < mappingSize ? mapping[position] : '\0';
+    return emitChar(letter);
+}
+
+size_t ReadAheadFileSource::checkBufferCount(size_t bufferSize, size_t bufferCount)
+{
+    if (bufferSize == 0 || bufferCount == 0)
+        throw CannotReadSourceException("Read-ahead needs at least one buffer of at least one byte!");
+    return bufferCount;
+}
+
+void ReadAheadFileSource::readAhead()
+{
+    try
+    {
+        for (;;)
+        {
+            Buffer *buffer;
+            {
+                std::unique_lock<std::mutex> lock(buffersMutex);
+                buffersCondition.wait(lock, [this] { return stopping || produced - released < buffers.size(); });
+                if (stopping)
+                    return;
+                buffer = &buffers[produced % buffers.size()];
+            }
+            auto start = std::chrono::steady_clock::now();
+            size_t length = 0;
+            INSTRUMENT(uint64_t readCalls = 0);
+            while (length < buffer->data.size())
+            {
+                ssize_t received = read(descriptor, buffer->data.data() + length, buffer->data.size() - length);
+                INSTRUMENT(++readCalls);
+                if (received == 0)
+                    break;
+                if (received == -1)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw CannotReadSourceException("Cannot read from file!");
+                }
+                length += received;
+            }
+            buffer->length = length;
+            {
+                std::lock_guard<std::mutex> lock(buffersMutex);
+                readTime += std::chrono::steady_clock::now() - start;
+                INSTRUMENT(statistics.systemCalls += readCalls);
+                if (length > 0)
+                    ++produced;
+                if (length < buffer->data.size())
+                    endOfFile = true;
+            }
+            buffersCondition.notify_all();
+            if (length < buffer->data.size())
+                return;
+        }
+    }
+    catch (...)
     {
-        position = position.nextLine();
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            readError = std::current_exception();
+        }
+        buffersCondition.notify_all();
     }
-    return currentCharacter;
 }
 
-NextCharacter SocketSource::getChar()
+bool ReadAheadFileSource::nextBuffer()
 {
-    char letter[1];
-    read(socketSource, letter, 1);
-    currentCharacter = NextCharacter(*(letter), position.getAbsolutePosition(),
-                                     position.getChar(), position.getLine());
-    position = position.nextChar();
-    if (letter[0] == '\n')
+    std::unique_lock<std::mutex> lock(buffersMutex);
+    if (holdingBuffer)
+    {
+        ++released;
+        holdingBuffer = false;
+        buffersCondition.notify_all();
+    }
+    auto start = std::chrono::steady_clock::now();
+    buffersCondition.wait(lock, [this] { return produced > released || endOfFile || readError; });
+    stallTime += std::chrono::steady_clock::now() - start;
+    if (produced > released)
     {
-        position = position.nextLine();
+        Buffer &buffer = buffers[released % buffers.size()];
+        current = buffer.data.data();
+        currentLength = buffer.length;
+        currentPosition = 0;
+        holdingBuffer = true;
+        INSTRUMENT(++statistics.refills);
+        return true;
     }
-    return currentCharacter;
+    if (readError)
+        std::rethrow_exception(readError);
+    return false;
+}
+
+NextCharacter ReadAheadFileSource::getChar()
+{
+    char letter = '\0';
+    if (currentPosition < currentLength || nextBuffer())
+        letter = current[currentPosition++];
+    return emitChar(letter);
+}
+
+bool SocketSource::fillBuffer()
+{
+    while (!endOfStream)
+    {
+        ssize_t received = read(socketSource, buffer.data(), buffer.size());
+        ++readCalls;
+        INSTRUMENT(++statistics.systemCalls);
+        if (received > 0)
+        {
+            INSTRUMENT(++statistics.refills);
+            bufferPosition = 0;
+            bufferLength = received;
+            return true;
+        }
+        if (received == 0)
+            endOfStream = true;
+        else if (errno != EINTR)
+            throw SocketProblemException("Cannot read from socket!");
+    }
+    return false;
+}
+
+NextCharacter SocketSource::getChar()
+{
+    char letter = '\0';
+    if (bufferPosition < bufferLength || fillBuffer())
+        letter = buffer[bufferPosition++];
+    return emitChar(letter);
 }
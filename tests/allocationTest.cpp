@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+#include "lexical_analyzer/tokenLookahead.hpp"
+#include "matrix.hpp"
+
+namespace
+{
+    thread_local uint64_t allocationCount = 0;
+}
+
+void *operator new(size_t size)
+{
+    ++allocationCount;
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    ++allocationCount;
+    size_t bytes = (size + static_cast<size_t>(alignment) - 1) & ~(static_cast<size_t>(alignment) - 1);
+    if (void *memory = std::aligned_alloc(static_cast<size_t>(alignment), bytes ? bytes : static_cast<size_t>(alignment)))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+TEST(AllocationTest, contiguousLexingTest)
+{
+    std::string code;
+    for (int i = 0; i < 1000; ++i)
+        code += "counter = counter + other_counter * 'a string literal longer than SSO' or 1234567890123 + 0.125e-3 ";
+    code += "# and a comment that is longer than SSO";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    for (int i = 0; i < 11; ++i)
+        lexicAna.getToken();
+    uint64_t allocationsBefore = allocationCount;
+    uint64_t tokenCount = 0;
+    while (lexicAna.getToken()->getType() != Token::TokenType::EndOfFileToken)
+        ++tokenCount;
+    // Only the Token copies of the literals and the comment outgrow the small string buffer.
+    EXPECT_EQ(allocationCount - allocationsBefore, 999 + 1);
+    EXPECT_EQ(tokenCount, 999 * 11 + 1);
+    EXPECT_EQ(lexicAna.getSymbolTable().size(), 4);
+}
+
+TEST(AllocationTest, compactLexingTest)
+{
+    std::string code;
+    for (int i = 0; i < 1000; ++i)
+        code += "counter = counter + other_counter * 'a string literal longer than SSO' or 1234567890123 + 0.125e-3 ";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    for (int i = 0; i < 11; ++i)
+        lexicAna.getCompactToken();
+    uint64_t allocationsBefore = allocationCount;
+    uint64_t tokenCount = 0;
+    while (lexicAna.getCompactToken()->type != Token::TokenType::EndOfFileToken)
+        ++tokenCount;
+    EXPECT_EQ(allocationCount - allocationsBefore, 0);
+    EXPECT_EQ(tokenCount, 999 * 11);
+}
+
+TEST(AllocationTest, symbolTableViewTest)
+{
+    std::string code = "first second first";
+    SymbolTable table;
+    Symbol first = table.internView(std::string_view(code).substr(0, 5));
+    uint64_t allocationsBefore = allocationCount;
+    Symbol again = table.internView(std::string_view(code).substr(13, 5));
+    Symbol copied = table.intern("first");
+    EXPECT_EQ(allocationCount - allocationsBefore, 0);
+    EXPECT_EQ(again.id, first.id);
+    EXPECT_EQ(copied.text.data(), code.data());
+}
+
+TEST(AllocationTest, lookaheadTest)
+{
+    std::string code;
+    for (int i = 0; i < 1000; ++i)
+        code += "result = compute(first, 'a string literal longer than SSO', 12.5) ";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenLookahead<16> lookahead(lexicAna);
+    lookahead.peek(15);
+    uint64_t allocationsBefore = allocationCount;
+    uint64_t tokenCount = 0;
+    while (lookahead.peek().getType() != Token::TokenType::EndOfFileToken)
+    {
+        lookahead.mark();
+        lookahead.peek(8);
+        lookahead.consume();
+        lookahead.rewind();
+        lookahead.consume();
+        ++tokenCount;
+    }
+    // Each literal past the prefilled window is copied into its Token exactly once.
+    EXPECT_EQ(allocationCount - allocationsBefore, 999);
+    EXPECT_EQ(tokenCount, 1000 * 10);
+}
+
+TEST(AllocationTest, matrixInPlaceTest)
+{
+    Matrix integers(64, 63);
+    Matrix otherIntegers(64, 63, Matrix::ElementType::Integer);
+    Matrix doubles(64, 63, Matrix::ElementType::Double);
+    Matrix otherDoubles(64, 63, Matrix::ElementType::Double);
+    uint64_t allocationsBefore = allocationCount;
+    for (int i = 0; i < 100; ++i)
+    {
+        integers += otherIntegers;
+        integers -= otherIntegers;
+        integers *= 3;
+        integers /= 3;
+        doubles += otherDoubles;
+        doubles -= otherDoubles;
+        doubles *= 1.5;
+        doubles /= 1.5;
+    }
+    Matrix sum = std::move(integers) + otherIntegers;
+    EXPECT_EQ(allocationCount - allocationsBefore, 0);
+    EXPECT_EQ(sum.size(), 64 * 63);
+}
@@ -7,8 +7,20 @@ TEST(FlagResolverTest, Default) {
   EXPECT_EQ(FlagResolver::Options::Help, FlagResolver::resolveOption("--h"));
   EXPECT_EQ(FlagResolver::Options::File, FlagResolver::resolveOption("--file"));
   EXPECT_EQ(FlagResolver::Options::File, FlagResolver::resolveOption("--f"));
+  EXPECT_EQ(FlagResolver::Options::MappedFile, FlagResolver::resolveOption("--mmap"));
+  EXPECT_EQ(FlagResolver::Options::MappedFile, FlagResolver::resolveOption("--m"));
+  EXPECT_EQ(FlagResolver::Options::StreamedFile, FlagResolver::resolveOption("--stream"));
+  EXPECT_EQ(FlagResolver::Options::StreamedFile, FlagResolver::resolveOption("--st"));
+  EXPECT_EQ(FlagResolver::Options::CachedFile, FlagResolver::resolveOption("--cache"));
+  EXPECT_EQ(FlagResolver::Options::CachedFile, FlagResolver::resolveOption("--c"));
+  EXPECT_EQ(FlagResolver::Options::Statistics, FlagResolver::resolveOption("--stats"));
+  EXPECT_EQ(FlagResolver::Options::Statistics, FlagResolver::resolveOption("--sts"));
+  EXPECT_EQ(FlagResolver::Options::Pipeline, FlagResolver::resolveOption("--pipeline"));
+  EXPECT_EQ(FlagResolver::Options::Pipeline, FlagResolver::resolveOption("--p"));
   EXPECT_EQ(FlagResolver::Options::Socket, FlagResolver::resolveOption("--socket"));
   EXPECT_EQ(FlagResolver::Options::Socket, FlagResolver::resolveOption("--sc"));
+  EXPECT_EQ(FlagResolver::Options::Server, FlagResolver::resolveOption("--server"));
+  EXPECT_EQ(FlagResolver::Options::Server, FlagResolver::resolveOption("--sv"));
   EXPECT_EQ(FlagResolver::Options::String, FlagResolver::resolveOption("--string"));
   EXPECT_EQ(FlagResolver::Options::String, FlagResolver::resolveOption("--s"));
 }
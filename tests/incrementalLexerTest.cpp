@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "lexical_analyzer/incrementalLexer.hpp"
+#include "testPrograms.hpp"
+
+namespace
+{
+    void expectSameAsFreshLexing(const IncrementalLexer &incremental)
+    {
+        IncrementalLexer fresh(incremental.getText());
+        const TokenStream &tokens = incremental.getTokens();
+        const TokenStream &expected = fresh.getTokens();
+        ASSERT_EQ(tokens.size(), expected.size());
+        EXPECT_EQ(tokens.getTypes(), expected.getTypes());
+        EXPECT_EQ(tokens.getSubtypes(), expected.getSubtypes());
+        EXPECT_EQ(tokens.getOffsets(), expected.getOffsets());
+        EXPECT_EQ(tokens.getPayloadKinds(), expected.getPayloadKinds());
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (tokens[i].payloadKind == CompactToken::PayloadKind::Symbol ||
+                tokens[i].payloadKind == CompactToken::PayloadKind::Text)
+                EXPECT_EQ(std::get<std::string>(incremental.expand(i).getValue()),
+                          std::get<std::string>(fresh.expand(i).getValue()));
+            else
+                EXPECT_EQ(tokens[i].index, expected[i].index);
+        }
+        ASSERT_EQ(incremental.getDiagnostics().size(), fresh.getDiagnostics().size());
+        for (size_t i = 0; i < fresh.getDiagnostics().size(); ++i)
+        {
+            EXPECT_EQ(incremental.getDiagnostics()[i].kind, fresh.getDiagnostics()[i].kind);
+            EXPECT_EQ(incremental.getDiagnostics()[i].absolutePosition, fresh.getDiagnostics()[i].absolutePosition);
+        }
+    }
+}
+
+TEST(IncrementalLexerTest, matchesLexicalAnalyzerTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(10);
+    IncrementalLexer incremental(program);
+    StringSource src(program);
+    LexicalAnalyzer lexicAna(src, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+    TokenStream serial = lexicAna.tokenizeAll();
+    EXPECT_EQ(incremental.getTokens().getTypes(), serial.getTypes());
+    EXPECT_EQ(incremental.getTokens().getOffsets(), serial.getOffsets());
+    EXPECT_EQ(incremental.resolvePosition(program.find("compute1")).getLine(), src.resolvePosition(program.find("compute1")).getLine());
+}
+
+TEST(IncrementalLexerTest, editInsideLineTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(50);
+    IncrementalLexer incremental(program);
+    incremental.edit(program.find("compute7"), 8, "renamed");
+    EXPECT_LT(incremental.getRelexedTokenCount(), 20);
+    expectSameAsFreshLexing(incremental);
+    size_t index = std::find(incremental.getTokens().getOffsets().begin(), incremental.getTokens().getOffsets().end(),
+                             program.find("compute7")) - incremental.getTokens().getOffsets().begin();
+    EXPECT_EQ(std::get<std::string>(incremental.expand(index).getValue()), "renamed");
+}
+
+TEST(IncrementalLexerTest, indentationChangeTest)
+{
+    std::string program = "if(a):\n  b = 1\n  c = 2\nd = 3\n  e = 4\n";
+    IncrementalLexer incremental(program);
+    incremental.edit(program.find("c = 2"), 0, "  ");
+    expectSameAsFreshLexing(incremental);
+    incremental.edit(0, 0, "x = 'value'\n");
+    EXPECT_EQ(incremental.getRelexedTokenCount(), 4);
+    expectSameAsFreshLexing(incremental);
+    incremental.edit(incremental.getText().find("  b"), 2, "");
+    expectSameAsFreshLexing(incremental);
+}
+
+TEST(IncrementalLexerTest, lineJoinAndSplitTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(5);
+    IncrementalLexer incremental(program);
+    size_t lineEnd = program.find('\n', program.find("compute2"));
+    incremental.edit(lineEnd, 1, "");
+    expectSameAsFreshLexing(incremental);
+    incremental.edit(lineEnd, 0, "\n\n    ");
+    expectSameAsFreshLexing(incremental);
+    incremental.edit(incremental.getText().size(), 0, "tail");
+    expectSameAsFreshLexing(incremental);
+    incremental.edit(0, incremental.getText().size(), "");
+    expectSameAsFreshLexing(incremental);
+    EXPECT_EQ(incremental.getTokens().size(), 1);
+}
+
+TEST(IncrementalLexerTest, diagnosticsTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(5) + "x = 'open\n" + TestPrograms::buildNestedProgram(5);
+    IncrementalLexer incremental(program);
+    ASSERT_EQ(incremental.getDiagnostics().size(), 1);
+    EXPECT_EQ(incremental.getDiagnostics()[0].kind, Diagnostic::Kind::MalformedStringLiteral);
+    incremental.edit(0, 0, "y = 99999999999999999999\n");
+    expectSameAsFreshLexing(incremental);
+    EXPECT_EQ(incremental.getDiagnostics().size(), 2);
+    size_t open = incremental.getText().find("'open");
+    incremental.edit(open + 5, 0, "'");
+    expectSameAsFreshLexing(incremental);
+    ASSERT_EQ(incremental.getDiagnostics().size(), 1);
+    EXPECT_EQ(incremental.getDiagnostics()[0].kind, Diagnostic::Kind::IntegerTooBig);
+}
+
+TEST(IncrementalLexerTest, randomEditsTest)
+{
+    const std::string fragments[] = {"", "\n", "  ", "\t", "a", "'", "12", "0x", "# c", ": ", "\n    x = 1\n", "  if(b):\n"};
+    std::mt19937 random(7);
+    IncrementalLexer incremental(TestPrograms::buildNestedProgram(12));
+    for (int i = 0; i < 300; ++i)
+    {
+        size_t size = incremental.getText().size();
+        size_t offset = random() % (size + 1);
+        size_t removed = std::min<size_t>(random() % 6, size - offset);
+        incremental.edit(offset, removed, fragments[random() % std::size(fragments)]);
+        expectSameAsFreshLexing(incremental);
+        if (HasFailure())
+            FAIL() << "edit " << i << " at " << offset;
+    }
+}
+
+TEST(IncrementalLexerTest, invalidEditTest)
+{
+    IncrementalLexer incremental("a = 1\n");
+    EXPECT_THROW(incremental.edit(7, 0, "b"), InvalidSourceEdit);
+    EXPECT_THROW(incremental.edit(4, 3, ""), InvalidSourceEdit);
+    EXPECT_EQ(incremental.getText(), "a = 1\n");
+}
+
+TEST(IncrementalLexerTest, typingKeepsSymbolTableBoundedTest)
+{
+    IncrementalLexer incremental("a = 1\n");
+    std::string typed;
+    for (int i = 0; i < 2000; ++i)
+    {
+        typed += static_cast<char>('a' + i % 26);
+        incremental.edit(4 + i, 0, typed.substr(i));
+        EXPECT_LE(incremental.getSymbolTable().size(), 2 * incremental.getTokens().size());
+    }
+    expectSameAsFreshLexing(incremental);
+    EXPECT_EQ(incremental.getText(), "a = " + typed + "1\n");
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+
+TEST(LexerStatisticsTest, recordTest)
+{
+    LexerStatistics statistics;
+    Token identifier = statistics.record(LexerStatistics::Phase::Identifiers, [] {
+        return Token(Token::TokenType::IdentifierToken, std::monostate{});
+    });
+    EXPECT_EQ(identifier.getType(), Token::TokenType::IdentifierToken);
+    statistics.record(LexerStatistics::Phase::Indentation, [] { return std::optional<Token>(); });
+    statistics.record(LexerStatistics::Phase::Whitespace, [] {});
+    statistics.countToken(Token(Token::TokenType::IdentifierToken, std::monostate{}));
+    statistics.recordIndentDepth(3);
+    statistics.recordIndentDepth(1);
+    EXPECT_EQ(statistics.getTokenCount(Token::TokenType::IdentifierToken), 2);
+    EXPECT_EQ(statistics.getTokenCount(), 2);
+    EXPECT_EQ(statistics.getMaxIndentDepth(), 3);
+    EXPECT_GT(statistics.getPhaseCycles(LexerStatistics::Phase::Identifiers), 0);
+}
+
+TEST(LexerStatisticsTest, reportTest)
+{
+    LexerStatistics statistics;
+    statistics.countToken(Token(Token::TokenType::NextLineToken, std::monostate{}));
+    statistics.setSourceStatistics(12, Instrumentation::SourceStatistics{2, 5});
+    EXPECT_EQ(statistics.toJson(),
+              "{\"tokens\":1,\"tokensByType\":{\"NextLineToken\":1},\"bytesConsumed\":12,\"sourceRefills\":2,"
+              "\"sourceSystemCalls\":5,\"maxIndentDepth\":0,\"cycles\":{\"indentation\":0,\"whitespace\":0,"
+              "\"identifiers\":0,\"numbers\":0,\"strings\":0,\"comments\":0,\"operators\":0,\"other\":0}}\n");
+    std::string text = statistics.toText();
+    EXPECT_NE(text.find("  NextLineToken"), std::string::npos);
+    EXPECT_NE(text.find("source system calls"), std::string::npos);
+    EXPECT_EQ(text.find("IdentifierToken"), std::string::npos);
+    EXPECT_STREQ(LexerStatistics::getName(Token::TokenType::ErrorToken), "ErrorToken");
+}
+
+#ifdef TKOM_INSTRUMENTATION
+TEST(LexerStatisticsTest, lexicalAnalyzerTest)
+{
+    std::string code = "if(a):\n    b = 'x' # note\n        c = 1\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    while (lexicAna.getToken()->getType() != Token::TokenType::EndOfFileToken)
+        ;
+    LexerStatistics statistics = lexicAna.getStatistics();
+    EXPECT_EQ(statistics.getTokenCount(Token::TokenType::IdentifierToken), 3);
+    EXPECT_EQ(statistics.getTokenCount(Token::TokenType::OpenBlockToken), 2);
+    EXPECT_EQ(statistics.getTokenCount(Token::TokenType::CommentToken), 1);
+    EXPECT_EQ(statistics.getTokenCount(Token::TokenType::EndOfFileToken), 1);
+    EXPECT_EQ(statistics.getBytesConsumed(), code.size());
+    EXPECT_EQ(statistics.getMaxIndentDepth(), 2);
+    EXPECT_GT(statistics.getPhaseCycles(LexerStatistics::Phase::Strings), 0);
+    EXPECT_EQ(statistics.getSourceStatistics().systemCalls, 0);
+}
+
+TEST(LexerStatisticsTest, mappedFileTest)
+{
+    MappedFileSource src("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer lexicAna(src);
+    while (lexicAna.getToken()->getType() != Token::TokenType::EndOfFileToken)
+        ;
+    LexerStatistics statistics = lexicAna.getStatistics();
+    EXPECT_EQ(statistics.getSourceStatistics().refills, 1);
+    EXPECT_EQ(statistics.getSourceStatistics().systemCalls, 5);
+    EXPECT_EQ(statistics.getBytesConsumed(), src.getSizeHint());
+}
+#endif
@@ -244,6 +244,33 @@ TEST(LexicalAnalyzerTest, TransKeywordTest)
     EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
 }
 
+TEST(LexicalAnalyzerTest, keywordLookupTest)
+{
+    static_assert(LexicalTable::findKeyword("asLongAs") == Token::TokenType::AsLongAsToken);
+    static_assert(!LexicalTable::findKeyword("aslongas"));
+    for (const LexicalTable::KeywordEntry &keyword : LexicalTable::keywords)
+        EXPECT_EQ(LexicalTable::findKeyword(keyword.word), keyword.type);
+    for (std::string_view word : {"", "x", "If", "an", "matrixx", "retur", "returns", "texts", "inverse", "orr"})
+        EXPECT_FALSE(LexicalTable::findKeyword(word));
+}
+
+TEST(LexicalAnalyzerTest, keywordPrefixIdentifierTest)
+{
+    StringSource src("integers matrix_1 if2");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), "integers");
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), "matrix_1");
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), "if2");
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
+}
+
 TEST(LexicalAnalyzerTest, commentKeywordTest)
 {
     StringSource src("#To jest komentarz\n");
@@ -298,6 +325,33 @@ TEST(LexicalAnalyzerTest, identifierKeywordTest)
     EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
 }
 
+TEST(LexicalAnalyzerTest, internedIdentifiersTest)
+{
+    StringSource src("bunny = carrot + bunny 'bunny'");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> first = lexicAna.getToken();
+    lexicAna.getToken();
+    std::optional<Token> second = lexicAna.getToken();
+    lexicAna.getToken();
+    std::optional<Token> third = lexicAna.getToken();
+    std::optional<Token> literal = lexicAna.getToken();
+    EXPECT_EQ(first->getSymbolId(), third->getSymbolId());
+    EXPECT_NE(first->getSymbolId(), second->getSymbolId());
+    EXPECT_EQ(literal->getSymbolId(), first->getSymbolId());
+    EXPECT_EQ(lexicAna.getSymbolTable().getText(second->getSymbolId()), "carrot");
+    EXPECT_EQ(std::get<std::string>(literal->getValue()), "bunny");
+    EXPECT_EQ(lexicAna.getSymbolTable().size(), 2);
+}
+
+TEST(LexicalAnalyzerTest, indentSymbolTableTest)
+{
+    StringSource src("if(bunny):\n    bunny = carrot\n");
+    LexicalAnalyzer lexicAna(src);
+    TokenStream stream = lexicAna.tokenizeAll();
+    EXPECT_EQ(lexicAna.getSymbolTable().size(), 2);
+    EXPECT_EQ(stream.getTables()->indentTable.getText(0), "    ");
+}
+
 TEST(LexicalAnalyzerTest, openCloseBracketsTest)
 {
     StringSource src("()[]");
@@ -378,6 +432,54 @@ TEST(LexicalAnalyzerTest, someOperators3Test)
     EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
 }
 
+TEST(LexicalAnalyzerTest, multiplicativeOperatorsTest)
+{
+    StringSource src("a / b * c");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::MultiplicativeOperatorToken);
+    EXPECT_EQ(token->getSubtype(), Token::TokenSubtype::DivisionToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::MultiplicativeOperatorToken);
+    EXPECT_EQ(token->getSubtype(), Token::TokenSubtype::MultiplicationToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
+}
+
+TEST(LexicalAnalyzerTest, trailingWhitespaceTest)
+{
+    StringSource src("a  \nb \t");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
+}
+
+TEST(LexicalAnalyzerTest, unindentifiedTest)
+{
+    StringSource src("@$a");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::UnindentifiedToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::UnindentifiedToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
+}
+
 TEST(LexicalAnalyzerTest, stringLiteralsTest)
 {
     std::string_view source = "'\\t\\nmamatata..43224\"\".:  '";
@@ -533,6 +635,120 @@ TEST(LexicalAnalyzerTest, doubleLiterals4Test)
     EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
 }
 
+TEST(LexicalAnalyzerTest, integerLimitTest)
+{
+    StringSource src("9223372036854775807 9223372036854775808");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IntegerLiteralToken);
+    EXPECT_EQ(std::get<int64_t>(token->getValue()), INT64_MAX);
+    EXPECT_THROW(lexicAna.getToken(), IntegerTooBig);
+}
+
+TEST(LexicalAnalyzerTest, hexLiteralsTest)
+{
+    StringSource src("0x1F 0XfF 0x7fffffffffffffff");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IntegerLiteralToken);
+    EXPECT_EQ(std::get<int64_t>(token->getValue()), 31);
+    token = lexicAna.getToken();
+    EXPECT_EQ(std::get<int64_t>(token->getValue()), 255);
+    token = lexicAna.getToken();
+    EXPECT_EQ(std::get<int64_t>(token->getValue()), INT64_MAX);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
+    StringSource malformedSrc("0x");
+    LexicalAnalyzer malformedAna(malformedSrc);
+    EXPECT_THROW(malformedAna.getToken(), WronglyDefinedNumberLiteral);
+    StringSource bigSrc("0x8000000000000000");
+    LexicalAnalyzer bigAna(bigSrc);
+    EXPECT_THROW(bigAna.getToken(), IntegerTooBig);
+}
+
+TEST(LexicalAnalyzerTest, exponentLiteralsTest)
+{
+    StringSource src("1.5e-3 2E+4 7e2 0.1234567890123456789");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::DoubleLiteralToken);
+    EXPECT_EQ(std::get<double>(token->getValue()), 1.5e-3);
+    token = lexicAna.getToken();
+    EXPECT_EQ(std::get<double>(token->getValue()), 2e4);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::DoubleLiteralToken);
+    EXPECT_EQ(std::get<double>(token->getValue()), 700.0);
+    token = lexicAna.getToken();
+    EXPECT_EQ(std::get<double>(token->getValue()), 0.1234567890123456789);
+    StringSource malformedSrc("3e+");
+    LexicalAnalyzer malformedAna(malformedSrc);
+    EXPECT_THROW(malformedAna.getToken(), WronglyDefinedNumberLiteral);
+    StringSource bigSrc("1e400");
+    LexicalAnalyzer bigAna(bigSrc);
+    EXPECT_THROW(bigAna.getToken(), IntegerTooBig);
+}
+
+TEST(LexicalAnalyzerTest, discardCommentsTest)
+{
+    std::string code = "a = 4 / 2 # " + std::string(5000, 'c') + "\n// " + std::string(5000, 'd') + "\nb // tail";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src, LexicalAnalyzer::CommentMode::Discard);
+    std::vector<Token::TokenType> expected = {
+        Token::TokenType::IdentifierToken, Token::TokenType::AssignmentOperatorToken,
+        Token::TokenType::IntegerLiteralToken, Token::TokenType::MultiplicativeOperatorToken,
+        Token::TokenType::IntegerLiteralToken, Token::TokenType::NextLineToken,
+        Token::TokenType::NextLineToken, Token::TokenType::IdentifierToken,
+        Token::TokenType::EndOfFileToken};
+    for (Token::TokenType type : expected)
+        EXPECT_EQ(lexicAna.getToken()->getType(), type);
+}
+
+TEST(LexicalAnalyzerTest, discardCommentsStreamedTest)
+{
+    FileSource keepSrc("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer keepAna(keepSrc);
+    FileSource discardSrc("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer discardAna(discardSrc, LexicalAnalyzer::CommentMode::Discard);
+    std::optional<Token> token;
+    do
+    {
+        token = keepAna.getToken();
+        if (token->getType() == Token::TokenType::CommentToken)
+            continue;
+        std::optional<Token> discardToken = discardAna.getToken();
+        EXPECT_EQ(discardToken->getType(), token->getType());
+        EXPECT_EQ(discardToken->getAbsolutePosition(), token->getAbsolutePosition());
+    } while (token->getType() != Token::TokenType::EndOfFileToken);
+}
+
+TEST(LexicalAnalyzerTest, collectDiagnosticsTest)
+{
+    StringSource src("a = 'unterminated + 2\nb = 99999999999999999999 + 3\nc = 0x\n  d\n\te = 1\nf = 1e\ng = 'ok'");
+    LexicalAnalyzer lexicAna(src, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+    std::vector<Token::TokenType> types;
+    std::optional<Token> token;
+    do
+    {
+        token = lexicAna.getToken();
+        types.push_back(token->getType());
+    } while (token->getType() != Token::TokenType::EndOfFileToken);
+    EXPECT_EQ(std::count(types.begin(), types.end(), Token::TokenType::ErrorToken), 5);
+    EXPECT_EQ(types[2], Token::TokenType::ErrorToken);
+    EXPECT_EQ(types[3], Token::TokenType::NextLineToken);
+    EXPECT_EQ(types[types.size() - 2], Token::TokenType::StringLiteralToken);
+    std::vector<Diagnostic::Kind> expected = {
+        Diagnostic::Kind::MalformedStringLiteral, Diagnostic::Kind::IntegerTooBig,
+        Diagnostic::Kind::MalformedHexLiteral, Diagnostic::Kind::InconsistentIndentCharacters,
+        Diagnostic::Kind::MalformedExponent};
+    const std::vector<Diagnostic> &diagnostics = lexicAna.getDiagnostics();
+    ASSERT_EQ(diagnostics.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(diagnostics[i].kind, expected[i]);
+    EXPECT_EQ(src.resolvePosition(diagnostics[1].absolutePosition).getLine(), 1);
+    EXPECT_EQ(src.resolvePosition(diagnostics[4].absolutePosition).getLine(), 5);
+    EXPECT_EQ(lexicAna.describe(diagnostics[1]), "Integer constant at 4:1 is too big!");
+}
+
 TEST(LexicalAnalyzerTest, IndentTestFAILURE)
 {
     std::string_view source = "  \n \n   \n";
@@ -572,6 +788,67 @@ TEST(LexicalAnalyzerTest, Indent2Test)
     token = lexicAna.getToken();
     EXPECT_EQ(token->getType(), Token::TokenType::EndOfFileToken);
 }
+TEST(LexicalAnalyzerTest, tokenPositionTest)
+{
+    StringSource src("integer age\n  age = 4");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(token->getAbsolutePosition(), 8);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::OpenBlockToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    Position position = src.resolvePosition(token->getAbsolutePosition());
+    EXPECT_EQ(position.getLine(), 1);
+    EXPECT_EQ(position.getChar(), 2);
+}
+TEST(LexicalAnalyzerTest, unchangedIndentPositionTest)
+{
+    StringSource src("a\n  b\n  c\n");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getAbsolutePosition(), 0);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::OpenBlockToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(token->getAbsolutePosition(), 4);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(token->getAbsolutePosition(), 8);
+    Position position = src.resolvePosition(token->getAbsolutePosition());
+    EXPECT_EQ(position.getLine(), 2);
+    EXPECT_EQ(position.getChar(), 2);
+}
+TEST(LexicalAnalyzerTest, compactTokenTest)
+{
+    static_assert(sizeof(CompactToken) == 16);
+    std::string code = "text name = 'abc' # note\n  name = 4.5 + 12";
+    StringSource compactSrc(code);
+    LexicalAnalyzer compactAna(compactSrc);
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    std::optional<CompactToken> compactToken = compactAna.getCompactToken();
+    std::optional<Token> token = lexicAna.getToken();
+    while (token->getType() != Token::TokenType::EndOfFileToken)
+    {
+        Token expanded = compactAna.expand(*compactToken);
+        EXPECT_EQ(expanded.getType(), token->getType());
+        EXPECT_EQ(expanded.getAbsolutePosition(), token->getAbsolutePosition());
+        EXPECT_EQ(expanded.getValue(), token->getValue());
+        compactToken = compactAna.getCompactToken();
+        token = lexicAna.getToken();
+    }
+    EXPECT_EQ(compactToken->type, Token::TokenType::EndOfFileToken);
+}
 //Przeparsowane kilka linijek mpp
 TEST(LexicalAnalyzerTest, FINALTEST)
 {
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "lexical_analyzer/token.hpp"
+#include "matrixKernels.hpp"
+
+TEST(MatrixTest, constructionTest)
+{
+    Matrix empty;
+    EXPECT_EQ(empty.getRows(), 0);
+    EXPECT_EQ(empty.getColumns(), 0);
+    EXPECT_EQ(empty.size(), 0);
+
+    Matrix zeros(3, 5, Matrix::ElementType::Double);
+    EXPECT_EQ(zeros.getRows(), 3);
+    EXPECT_EQ(zeros.getColumns(), 5);
+    EXPECT_EQ(zeros.getElementType(), Matrix::ElementType::Double);
+    ASSERT_EQ(zeros.getValues<double>().size(), 15);
+    EXPECT_TRUE(std::all_of(zeros.getValues<double>().begin(), zeros.getValues<double>().end(),
+                            [](double value) { return value == 0.0; }));
+
+    Matrix integers(2, 3, {1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(integers.getElementType(), Matrix::ElementType::Integer);
+    EXPECT_EQ(integers.at<int64_t>(0, 2), 3);
+    EXPECT_EQ(integers.at<int64_t>(1, 0), 4);
+    Matrix doubles(1, 2, {0.5, -2.25});
+    EXPECT_EQ(doubles.at<double>(0, 1), -2.25);
+    EXPECT_THROW(Matrix(2, 2, {1, 2, 3}), MatrixDimensionMismatch);
+    EXPECT_THROW(Matrix(2, 2, {1.0, 2.0, 3.0, 4.0, 5.0}), MatrixDimensionMismatch);
+}
+
+TEST(MatrixTest, layoutTest)
+{
+    EXPECT_LE(sizeof(Matrix), 24);
+    EXPECT_EQ(sizeof(TokenVariant), sizeof(std::variant<std::monostate, int64_t, double, std::string>));
+    for (uint32_t columns = 1; columns < 20; ++columns)
+    {
+        Matrix integers(3, columns);
+        Matrix doubles(3, columns, Matrix::ElementType::Double);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(integers.getValues<int64_t>().data()) % Matrix::ALIGNMENT, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(doubles.getValues<double>().data()) % Matrix::ALIGNMENT, 0);
+        Matrix copy = doubles;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(copy.getValues<double>().data()) % Matrix::ALIGNMENT, 0);
+        EXPECT_EQ(copy, doubles);
+    }
+    Matrix matrix(2, 3);
+    matrix.at<int64_t>(1, 1) = 7;
+    EXPECT_EQ(matrix.getValues<int64_t>()[4], 7);
+    Matrix moved = std::move(matrix);
+    EXPECT_EQ(moved.at<int64_t>(1, 1), 7);
+    EXPECT_EQ(matrix.size(), 0);
+    matrix = moved;
+    EXPECT_EQ(matrix, moved);
+}
+
+TEST(MatrixTest, accessErrorsTest)
+{
+    Matrix matrix(2, 3, {1, 2, 3, 4, 5, 6});
+    EXPECT_THROW(matrix.at<int64_t>(2, 0), MatrixIndexOutOfRange);
+    EXPECT_THROW(matrix.at<int64_t>(0, 3), MatrixIndexOutOfRange);
+    EXPECT_THROW(matrix.at<double>(0, 0), MatrixTypeMismatch);
+    const Matrix &constant = matrix;
+    EXPECT_THROW(constant.getValues<double>(), MatrixTypeMismatch);
+    EXPECT_EQ(constant.getValues<int64_t>()[5], 6);
+}
+
+TEST(MatrixTest, oversizedTest)
+{
+    EXPECT_THROW(Matrix(1u << 31, 1u << 31), MatrixTooLarge);
+    EXPECT_THROW(Matrix(UINT32_MAX, UINT32_MAX, Matrix::ElementType::Double), MatrixTooLarge);
+}
+
+TEST(MatrixTest, equalityTest)
+{
+    Matrix matrix(2, 3, {1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(matrix, Matrix(2, 3, {1, 2, 3, 4, 5, 6}));
+    EXPECT_NE(matrix, Matrix(3, 2, {1, 2, 3, 4, 5, 6}));
+    EXPECT_NE(matrix, Matrix(2, 3, {1, 2, 3, 4, 5, 7}));
+    EXPECT_NE(matrix, Matrix(2, 3, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}));
+    EXPECT_NE(Matrix(0, 4), Matrix(4, 0));
+    Token token(Token::TokenType::MatrixToken, matrix);
+    EXPECT_EQ(token, Token(Token::TokenType::MatrixToken, Matrix(2, 3, {1, 2, 3, 4, 5, 6})));
+    EXPECT_NE(token, Token(Token::TokenType::MatrixToken, Matrix(1, 6, {1, 2, 3, 4, 5, 6})));
+}
+
+namespace
+{
+    std::vector<MatrixKernels::Kernel> availableKernels()
+    {
+        std::vector<MatrixKernels::Kernel> kernels{MatrixKernels::Kernel::Scalar};
+        if (MatrixKernels::bestKernel() != MatrixKernels::Kernel::Scalar)
+            kernels.push_back(MatrixKernels::Kernel::SSE2);
+        if (MatrixKernels::bestKernel() == MatrixKernels::Kernel::AVX2)
+            kernels.push_back(MatrixKernels::Kernel::AVX2);
+        return kernels;
+    }
+}
+
+TEST(MatrixTest, kernelsTest)
+{
+    std::mt19937_64 random(11);
+    for (size_t count : {0, 1, 3, 4, 7, 8, 15, 16, 17, 63, 1000})
+    {
+        std::vector<int64_t> integers(count);
+        std::vector<int64_t> otherIntegers(count);
+        std::vector<double> doubles(count);
+        std::vector<double> otherDoubles(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            integers[i] = static_cast<int64_t>(random());
+            otherIntegers[i] = i % 5 == 0 ? INT64_MIN : static_cast<int64_t>(random() >> (i % 64));
+            doubles[i] = static_cast<double>(static_cast<int64_t>(random())) / 4096.0;
+            otherDoubles[i] = static_cast<double>(i) - 0.5;
+        }
+        auto expectSameAsScalar = [&](auto operation, auto &values) {
+            std::remove_reference_t<decltype(values)> expected(count);
+            std::remove_reference_t<decltype(values)> result(count);
+            operation(std::span(expected), MatrixKernels::Kernel::Scalar);
+            for (MatrixKernels::Kernel kernel : availableKernels())
+            {
+                operation(std::span(result), kernel);
+                EXPECT_EQ(result, expected) << "kernel " << static_cast<int>(kernel) << ", " << count << " elements";
+            }
+        };
+        expectSameAsScalar([&](std::span<int64_t> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::add<int64_t>(integers, otherIntegers, result, kernel);
+        }, integers);
+        expectSameAsScalar([&](std::span<int64_t> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::subtract<int64_t>(integers, otherIntegers, result, kernel);
+        }, integers);
+        expectSameAsScalar([&](std::span<int64_t> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::multiply<int64_t>(integers, -0x123456789LL, result, kernel);
+        }, integers);
+        expectSameAsScalar([&](std::span<int64_t> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::divide<int64_t>(otherIntegers, -1, result, kernel);
+        }, integers);
+        expectSameAsScalar([&](std::span<double> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::add<double>(doubles, otherDoubles, result, kernel);
+        }, doubles);
+        expectSameAsScalar([&](std::span<double> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::subtract<double>(doubles, otherDoubles, result, kernel);
+        }, doubles);
+        expectSameAsScalar([&](std::span<double> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::multiply<double>(doubles, -1.75, result, kernel);
+        }, doubles);
+        expectSameAsScalar([&](std::span<double> result, MatrixKernels::Kernel kernel) {
+            MatrixKernels::divide<double>(doubles, 3.0, result, kernel);
+        }, doubles);
+    }
+    std::vector<int64_t> wrapped{INT64_MAX, INT64_MIN, 3};
+    for (MatrixKernels::Kernel kernel : availableKernels())
+    {
+        std::vector<int64_t> result(3);
+        MatrixKernels::multiply<int64_t>(wrapped, 2, result, kernel);
+        EXPECT_EQ(result, (std::vector<int64_t>{-2, 0, 6}));
+    }
+}
+
+TEST(MatrixTest, arithmeticTest)
+{
+    Matrix integers(2, 3, {1, 2, 3, 4, 5, 6});
+    Matrix otherIntegers(2, 3, {6, 5, 4, 3, 2, 1});
+    EXPECT_EQ(integers + otherIntegers, Matrix(2, 3, {7, 7, 7, 7, 7, 7}));
+    EXPECT_EQ(integers - otherIntegers, Matrix(2, 3, {-5, -3, -1, 1, 3, 5}));
+    EXPECT_EQ(integers * 3, Matrix(2, 3, {3, 6, 9, 12, 15, 18}));
+    EXPECT_EQ(-2 * integers, Matrix(2, 3, {-2, -4, -6, -8, -10, -12}));
+    EXPECT_EQ(integers / 2, Matrix(2, 3, {0, 1, 1, 2, 2, 3}));
+    EXPECT_EQ((integers + otherIntegers) * 2 - integers, Matrix(2, 3, {13, 12, 11, 10, 9, 8}));
+
+    Matrix doubles(2, 2, {1.0, 2.0, 3.0, 4.0});
+    EXPECT_EQ(doubles * 0.5, Matrix(2, 2, {0.5, 1.0, 1.5, 2.0}));
+    EXPECT_EQ(doubles * 2, Matrix(2, 2, {2.0, 4.0, 6.0, 8.0}));
+    EXPECT_EQ(doubles / 4, Matrix(2, 2, {0.25, 0.5, 0.75, 1.0}));
+    EXPECT_EQ(doubles - doubles, Matrix(2, 2, Matrix::ElementType::Double));
+
+    EXPECT_THROW(integers + Matrix(3, 2, {1, 2, 3, 4, 5, 6}), MatrixDimensionMismatch);
+    EXPECT_THROW(doubles + Matrix(2, 2, {1, 2, 3, 4}), MatrixTypeMismatch);
+    EXPECT_THROW(integers * 0.5, MatrixTypeMismatch);
+    EXPECT_THROW(integers / 0, MatrixDivisionByZero);
+    EXPECT_EQ(integers, Matrix(2, 3, {1, 2, 3, 4, 5, 6}));
+}
+
+TEST(MatrixTest, inPlaceArithmeticTest)
+{
+    Matrix matrix(4, 5, Matrix::ElementType::Double);
+    Matrix step(4, 5, Matrix::ElementType::Double);
+    for (double &value : step.getValues<double>())
+        value = 1.5;
+    const double *storage = matrix.getValues<double>().data();
+    matrix += step;
+    matrix += step;
+    matrix -= step;
+    matrix *= 4;
+    matrix /= 2.0;
+    EXPECT_EQ(matrix.getValues<double>().data(), storage);
+    for (double value : matrix.getValues<double>())
+        EXPECT_EQ(value, 3.0);
+    Matrix sum = std::move(matrix) + step;
+    EXPECT_EQ(sum.getValues<double>().data(), storage);
+    EXPECT_EQ(sum.at<double>(3, 4), 4.5);
+}
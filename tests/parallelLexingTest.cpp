@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+#include "testPrograms.hpp"
+
+namespace
+{
+    void expectSameStreams(const TokenStream &parallel, const TokenStream &serial)
+    {
+        ASSERT_EQ(parallel.size(), serial.size());
+        EXPECT_EQ(parallel.getTypes(), serial.getTypes());
+        EXPECT_EQ(parallel.getSubtypes(), serial.getSubtypes());
+        EXPECT_EQ(parallel.getOffsets(), serial.getOffsets());
+        EXPECT_EQ(parallel.getPayloadKinds(), serial.getPayloadKinds());
+        EXPECT_EQ(parallel.getPayloads(), serial.getPayloads());
+    }
+}
+
+TEST(ParallelLexingTest, matchesSerialTest)
+{
+    for (char indentChar : {' ', '\t'})
+    {
+        std::string program = TestPrograms::buildNestedProgram(200, 7, indentChar, 1);
+        StringSource serialSrc(program);
+        LexicalAnalyzer serialAna(serialSrc);
+        TokenStream serial = serialAna.tokenizeAll();
+        for (size_t chunkSize : {64, 1000, 4096})
+        {
+            StringSource src(program);
+            LexicalAnalyzer lexicAna(src);
+            TokenStream parallel;
+            lexicAna.tokenizeAllParallel(parallel, 4, chunkSize);
+            expectSameStreams(parallel, serial);
+            EXPECT_EQ(lexicAna.expand(parallel[2]).getType(), Token::TokenType::IdentifierToken);
+            EXPECT_EQ(std::get<std::string>(lexicAna.expand(parallel[2]).getValue()), "compute0");
+            Position position = src.resolvePosition(parallel.getOffsets().back());
+            EXPECT_EQ(position.getLine(), serialSrc.resolvePosition(serial.getOffsets().back()).getLine());
+        }
+    }
+}
+
+TEST(ParallelLexingTest, mappedFileTest)
+{
+    MappedFileSource serialSrc("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer serialAna(serialSrc, LexicalAnalyzer::CommentMode::Discard);
+    TokenStream serial = serialAna.tokenizeAll();
+    MappedFileSource src("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer lexicAna(src, LexicalAnalyzer::CommentMode::Discard);
+    TokenStream parallel;
+    lexicAna.tokenizeAllParallel(parallel, 3, 32);
+    expectSameStreams(parallel, serial);
+}
+
+TEST(ParallelLexingTest, diagnosticsTest)
+{
+    std::string program = "a = 1\n b = 'open\n\tc = 2\n d = 99999999999999999999 + 'x\n" +
+                          TestPrograms::buildNestedProgram(20, 7, ' ', 1) +
+                          "e = 0x\n    f\n   g\n";
+    StringSource serialSrc(program);
+    LexicalAnalyzer serialAna(serialSrc, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+    TokenStream serial = serialAna.tokenizeAll();
+    StringSource src(program);
+    LexicalAnalyzer lexicAna(src, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+    TokenStream parallel;
+    lexicAna.tokenizeAllParallel(parallel, 2, 16);
+    expectSameStreams(parallel, serial);
+    ASSERT_EQ(lexicAna.getDiagnostics().size(), serialAna.getDiagnostics().size());
+    EXPECT_EQ(lexicAna.getDiagnostics().size(), 5);
+    for (size_t i = 0; i < serialAna.getDiagnostics().size(); ++i)
+    {
+        EXPECT_EQ(lexicAna.getDiagnostics()[i].kind, serialAna.getDiagnostics()[i].kind);
+        EXPECT_EQ(lexicAna.describe(lexicAna.getDiagnostics()[i]), serialAna.describe(serialAna.getDiagnostics()[i]));
+    }
+
+    StringSource throwingSrc(program);
+    LexicalAnalyzer throwingAna(throwingSrc);
+    TokenStream throwing;
+    try
+    {
+        throwingAna.tokenizeAllParallel(throwing, 2, 16);
+        FAIL();
+    }
+    catch (WronglyDefinedStringLiteral &ex)
+    {
+        EXPECT_EQ(std::string(ex.what()), "String literal at 5:1 is malformed.");
+    }
+}
@@ -9,10 +9,30 @@
 #include <unistd.h>
 #include <thread>
 #include <chrono>
+#include <string>
+#include <iostream>
 
 struct ClientTCP
 {
   static void run(const char *message, int PORT)
+  {
+    close(connectAndSend(message, PORT));
+  }
+
+  static std::string runAndReceive(const char *message, int PORT)
+  {
+    int sendSocket = connectAndSend(message, PORT);
+    shutdown(sendSocket, SHUT_WR);
+    std::string response;
+    char buffer[1024];
+    ssize_t received;
+    while ((received = read(sendSocket, buffer, sizeof buffer)) > 0)
+      response.append(buffer, received);
+    close(sendSocket);
+    return response;
+  }
+
+  static int connectAndSend(const char *message, int PORT)
   {
     try
     {
@@ -42,7 +62,7 @@ struct ClientTCP
       }
       if (write(sendSocket, message, strlen(message)) == -1)
         throw "Error in sending data!";
-      close(sendSocket);
+      return sendSocket;
     }
     catch (const char *msg)
     {
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Generated programs shared by the tests that compare a lexing strategy against plain serial lexing.
+namespace TestPrograms
+{
+    // One function using keywords, comments, string, hex and exponent literals and two indent levels.
+    inline const std::string function = "function integer compute(integer first):\n"
+                                        "    text label = 'computed value' # note\n"
+                                        "    if(first >= 0x1F):\n"
+                                        "        first = first * 2.5e-3 // halve\n"
+                                        "    return first\n";
+
+    // blockCount numbered functions whose bodies nest one level deeper per block, restarting after
+    // maxDepth levels, each level indented by indentWidth more indentChar characters.
+    inline std::string buildNestedProgram(uint32_t blockCount, uint32_t maxDepth = 4, char indentChar = ' ',
+                                          uint32_t indentWidth = 2)
+    {
+        std::string program;
+        for (uint32_t block = 0; block < blockCount; ++block)
+        {
+            uint32_t depth = block % maxDepth;
+            program += "function integer compute" + std::to_string(block) + "(integer first):\n";
+            for (uint32_t level = 1; level <= depth + 1; ++level)
+            {
+                program += std::string(level * indentWidth, indentChar) + "if(first >= " + std::to_string(level) + "):\n";
+                program += std::string((level + 1) * indentWidth, indentChar) + "text label = 'level " +
+                           std::to_string(level) + "' # note\n";
+            }
+            program += std::string(indentWidth, indentChar) + "first = first * 0x1F + 2.5e-3 // dedent\n";
+            program += "\n";
+        }
+        return program;
+    }
+}
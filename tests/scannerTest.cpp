@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "lexical_analyzer/scanner.hpp"
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+
+namespace
+{
+    std::vector<Scanner::Kernel> availableKernels()
+    {
+        std::vector<Scanner::Kernel> kernels{Scanner::Kernel::Scalar};
+        if (Scanner::bestKernel() != Scanner::Kernel::Scalar)
+            kernels.push_back(Scanner::Kernel::SSE2);
+        if (Scanner::bestKernel() == Scanner::Kernel::AVX2)
+            kernels.push_back(Scanner::Kernel::AVX2);
+        return kernels;
+    }
+}
+
+TEST(ScannerTest, kernelsAgreeTest)
+{
+    std::mt19937 generator(7);
+    const std::string alphabet = std::string(" \t\r\v\f\n'\"#ab7") + '\0' + '\x7f' + '\x80' + '\x1b';
+    std::uniform_int_distribution<size_t> letter(0, alphabet.size() - 1);
+    std::uniform_int_distribution<int> runLength(0, 70);
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string text;
+        while (text.size() < 300)
+        {
+            char filler = i % 2 ? ' ' : 'x';
+            text.append(runLength(generator), filler);
+            text.push_back(alphabet[letter(generator)]);
+        }
+        for (size_t from = 0; from < text.size(); from += 13)
+        {
+            size_t nonSpace = Scanner::findNonSpace(text, from, Scanner::Kernel::Scalar);
+            size_t lineEnd = Scanner::findLineEnd(text, from, Scanner::Kernel::Scalar);
+            size_t stringEnd = Scanner::findStringEnd(text, from, '\'', Scanner::Kernel::Scalar);
+            for (Scanner::Kernel kernel : availableKernels())
+            {
+                EXPECT_EQ(Scanner::findNonSpace(text, from, kernel), nonSpace);
+                EXPECT_EQ(Scanner::findLineEnd(text, from, kernel), lineEnd);
+                EXPECT_EQ(Scanner::findStringEnd(text, from, '\'', kernel), stringEnd);
+            }
+        }
+    }
+}
+
+TEST(ScannerTest, bufferedLexingTest)
+{
+    MappedFileSource bufferedSrc("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer bufferedAna(bufferedSrc);
+    FileSource src("../tests/res/sampleCode.mpp");
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token;
+    do
+    {
+        token = lexicAna.getToken();
+        std::optional<Token> bufferedToken = bufferedAna.getToken();
+        EXPECT_EQ(bufferedToken->getType(), token->getType());
+        EXPECT_EQ(bufferedToken->getAbsolutePosition(), token->getAbsolutePosition());
+        EXPECT_EQ(bufferedToken->getValue(), token->getValue());
+    } while (token->getType() != Token::TokenType::EndOfFileToken);
+}
+
+TEST(ScannerTest, bufferedSpansTest)
+{
+    std::string comment = "# " + std::string(100, 'c');
+    std::string literal = std::string(70, 's');
+    std::string code = comment + "\ntext label = '" + literal + "'     // trailing\n\t\t x";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    std::optional<Token> token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::CommentToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), comment);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    token = lexicAna.getToken();
+    token = lexicAna.getToken();
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::StringLiteralToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), literal);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::CommentToken);
+    EXPECT_EQ(std::get<std::string>(token->getValue()), "// trailing");
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::NextLineToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::OpenBlockToken);
+    token = lexicAna.getToken();
+    EXPECT_EQ(token->getType(), Token::TokenType::IdentifierToken);
+    Position position = src.resolvePosition(token->getAbsolutePosition());
+    EXPECT_EQ(position.getLine(), 2);
+    EXPECT_EQ(position.getChar(), 3);
+}
+
+TEST(ScannerTest, bufferedLongCommentTest)
+{
+    std::string code = "# " + std::string(3000, 'c');
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    EXPECT_THROW(lexicAna.getToken(), TooLongStringLiteral);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <sys/resource.h>
+#include "helpers/socketServer.hpp"
+#include "clientTCP.hpp"
+
+std::string firstIdentifier(LexicalAnalyzer &analyzer)
+{
+  std::optional<Token> token = analyzer.getToken();
+  while (token->getType() != Token::TokenType::IdentifierToken &&
+         token->getType() != Token::TokenType::EndOfFileToken)
+    token = analyzer.getToken();
+  if (token->getType() == Token::TokenType::EndOfFileToken)
+    return "";
+  return std::string(std::get<std::string>(token->getValue()));
+}
+
+TEST(SocketServerTest, ManyClientsTest)
+{
+  SocketServer server(0, 4, firstIdentifier);
+  std::thread serverThread([&] { server.run(); });
+
+  const int clientCount = 64;
+  std::vector<std::string> responses(clientCount);
+  std::vector<std::thread> clients;
+  for (int i = 0; i < clientCount; ++i)
+    clients.emplace_back([&, i] {
+      std::string program = "integer client" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+      responses[i] = ClientTCP::runAndReceive(program.c_str(), server.getPort());
+    });
+  for (auto &client : clients)
+    client.join();
+  server.stop();
+  serverThread.join();
+
+  for (int i = 0; i < clientCount; ++i)
+    EXPECT_EQ(responses[i], "client" + std::to_string(i));
+}
+
+TEST(SocketServerTest, LexicalErrorTest)
+{
+  SocketServer server(0, 0, firstIdentifier);
+  EXPECT_EQ(server.getWorkerCount(), 1);
+  std::thread serverThread([&] { server.run(); });
+  std::string response = ClientTCP::runAndReceive("'not closed\n", server.getPort());
+  server.stop();
+  serverThread.join();
+  EXPECT_NE(response.find("malformed"), std::string::npos);
+}
+
+TEST(SocketServerTest, ProgramTooLargeTest)
+{
+  SocketServer server(0, 1, firstIdentifier, 64);
+  std::thread serverThread([&] { server.run(); });
+  std::string program;
+  for (int i = 0; i < 16; ++i)
+    program += "integer x = " + std::to_string(i) + "\n";
+  std::string tooLarge = ClientTCP::runAndReceive(program.c_str(), server.getPort());
+  std::string small = ClientTCP::runAndReceive("integer y = 1\n", server.getPort());
+  server.stop();
+  serverThread.join();
+  EXPECT_NE(tooLarge.find("maximum size"), std::string::npos);
+  EXPECT_EQ(small, "y");
+}
+
+TEST(SocketServerTest, ClientGoneTest)
+{
+  SocketServer server(0, 1, [](LexicalAnalyzer &analyzer) {
+    std::string identifier = firstIdentifier(analyzer);
+    if (identifier != "gone")
+      return identifier;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return std::string(1 << 22, 'x');
+  });
+  std::thread serverThread([&] { server.run(); });
+  int gone = ClientTCP::connectAndSend("integer gone\n", server.getPort());
+  shutdown(gone, SHUT_WR);
+  close(gone);
+  std::string response = ClientTCP::runAndReceive("integer stayed\n", server.getPort());
+  server.stop();
+  serverThread.join();
+  EXPECT_EQ(response, "stayed");
+}
+
+TEST(SocketServerTest, FailedSetupReleasesDescriptorsTest)
+{
+  int lowestFree = dup(0);
+  close(lowestFree);
+  rlimit limit;
+  getrlimit(RLIMIT_NOFILE, &limit);
+  // Leaves room for the listening socket only, so creating the event queue fails.
+  rlimit lowered{static_cast<rlim_t>(lowestFree + 1), limit.rlim_max};
+  setrlimit(RLIMIT_NOFILE, &lowered);
+  EXPECT_THROW(SocketServer(0, 1, firstIdentifier), SocketProblemException);
+  setrlimit(RLIMIT_NOFILE, &limit);
+  int reopened = dup(0);
+  close(reopened);
+  EXPECT_EQ(reopened, lowestFree);
+}
@@ -12,13 +12,13 @@ TEST(SourceTest, openStringTest)
     NextCharacter letter = src.getCurrentCharacter();
     EXPECT_EQ(letter.nextLetter, 't');
     EXPECT_EQ(letter.absolutePosition, 0);
-    EXPECT_EQ(letter.characterPosition, 0);
-    EXPECT_EQ(letter.linePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
     letter = src.getChar();
     EXPECT_EQ(letter.nextLetter, 'e');
     EXPECT_EQ(letter.absolutePosition, 1);
-    EXPECT_EQ(letter.characterPosition, 1);
-    EXPECT_EQ(letter.linePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 1);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
 }
 
 TEST(SourceTest, openFileTest)
@@ -28,13 +28,131 @@ TEST(SourceTest, openFileTest)
     NextCharacter letter = src.getCurrentCharacter();
     EXPECT_EQ(letter.nextLetter, 'L');
     EXPECT_EQ(letter.absolutePosition, 0);
-    EXPECT_EQ(letter.characterPosition, 0);
-    EXPECT_EQ(letter.linePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
     letter = src.getChar();
     EXPECT_EQ(letter.nextLetter, 'o');
     EXPECT_EQ(letter.absolutePosition, 1);
-    EXPECT_EQ(letter.characterPosition, 1);
-    EXPECT_EQ(letter.linePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 1);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
+}
+
+TEST(SourceTest, linePositionTest)
+{
+    StringSource src("ab\ncd\n\ne");
+    src.open();
+    NextCharacter letter = src.getCurrentCharacter();
+    while (letter.nextLetter != '\0')
+        letter = src.getChar();
+    Position position = src.resolvePosition(1);
+    EXPECT_EQ(position.getLine(), 0);
+    EXPECT_EQ(position.getChar(), 1);
+    position = src.resolvePosition(2);
+    EXPECT_EQ(position.getLine(), 0);
+    EXPECT_EQ(position.getChar(), 2);
+    position = src.resolvePosition(4);
+    EXPECT_EQ(position.getLine(), 1);
+    EXPECT_EQ(position.getChar(), 1);
+    position = src.resolvePosition(6);
+    EXPECT_EQ(position.getLine(), 2);
+    EXPECT_EQ(position.getChar(), 0);
+    position = src.resolvePosition(7);
+    EXPECT_EQ(position.getLine(), 3);
+    EXPECT_EQ(position.getChar(), 0);
+    EXPECT_EQ(src.getLinePosition(4), "1:1");
+}
+
+TEST(SourceTest, openMappedFileTest)
+{
+    MappedFileSource src("../tests/res/sampleText.txt");
+    src.open();
+    NextCharacter letter = src.getCurrentCharacter();
+    EXPECT_EQ(letter.nextLetter, 'L');
+    EXPECT_EQ(letter.absolutePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
+    letter = src.getChar();
+    EXPECT_EQ(letter.nextLetter, 'o');
+    EXPECT_EQ(letter.absolutePosition, 1);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 1);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
+}
+
+TEST(SourceTest, mappedFileMatchesFileTest)
+{
+    FileSource fileSrc("../tests/res/sampleText.txt");
+    MappedFileSource mappedSrc("../tests/res/sampleText.txt");
+    fileSrc.open();
+    mappedSrc.open();
+    NextCharacter expected = fileSrc.getCurrentCharacter();
+    NextCharacter letter = mappedSrc.getCurrentCharacter();
+    while (expected.nextLetter != '\0')
+    {
+        EXPECT_EQ(letter.nextLetter, expected.nextLetter);
+        EXPECT_EQ(letter.absolutePosition, expected.absolutePosition);
+        EXPECT_EQ(mappedSrc.resolvePosition(letter.absolutePosition).getChar(),
+                  fileSrc.resolvePosition(expected.absolutePosition).getChar());
+        EXPECT_EQ(mappedSrc.resolvePosition(letter.absolutePosition).getLine(),
+                  fileSrc.resolvePosition(expected.absolutePosition).getLine());
+        expected = fileSrc.getChar();
+        letter = mappedSrc.getChar();
+    }
+    EXPECT_EQ(letter.nextLetter, '\0');
+}
+
+TEST(SourceTest, mappedFileWrongPathTest)
+{
+    MappedFileSource src("../tests/res/notExisting.txt");
+    EXPECT_THROW(src.open(), WrongFilepathException);
+}
+
+TEST(SourceTest, openReadAheadFileTest)
+{
+    ReadAheadFileSource src("../tests/res/sampleText.txt");
+    src.open();
+    NextCharacter letter = src.getCurrentCharacter();
+    EXPECT_EQ(letter.nextLetter, 'L');
+    EXPECT_EQ(letter.absolutePosition, 0);
+    letter = src.getChar();
+    EXPECT_EQ(letter.nextLetter, 'o');
+    EXPECT_EQ(letter.absolutePosition, 1);
+}
+
+TEST(SourceTest, readAheadFileMatchesFileTest)
+{
+    FileSource fileSrc("../tests/res/sampleText.txt");
+    ReadAheadFileSource readAheadSrc("../tests/res/sampleText.txt", 16, 2);
+    fileSrc.open();
+    readAheadSrc.open();
+    NextCharacter expected = fileSrc.getCurrentCharacter();
+    NextCharacter letter = readAheadSrc.getCurrentCharacter();
+    while (expected.nextLetter != '\0')
+    {
+        EXPECT_EQ(letter.nextLetter, expected.nextLetter);
+        EXPECT_EQ(letter.absolutePosition, expected.absolutePosition);
+        expected = fileSrc.getChar();
+        letter = readAheadSrc.getChar();
+    }
+    EXPECT_EQ(letter.nextLetter, '\0');
+    EXPECT_EQ(readAheadSrc.getChar().nextLetter, '\0');
+    EXPECT_EQ(readAheadSrc.getLinePosition(letter.absolutePosition),
+              fileSrc.getLinePosition(expected.absolutePosition));
+}
+
+TEST(SourceTest, readAheadFileWrongPathTest)
+{
+    ReadAheadFileSource src("../tests/res/notExisting.txt");
+    EXPECT_THROW(src.open(), WrongFilepathException);
+}
+
+TEST(SourceTest, readAheadFileZeroBufferSizeTest)
+{
+    EXPECT_THROW(ReadAheadFileSource("../tests/res/sampleText.txt", 0, 2), CannotReadSourceException);
+}
+
+TEST(SourceTest, readAheadFileZeroBufferCountTest)
+{
+    EXPECT_THROW(ReadAheadFileSource("../tests/res/sampleText.txt", 16, 0), CannotReadSourceException);
 }
 
 TEST(SourceTest, openSocketTest)
@@ -52,11 +170,40 @@ TEST(SourceTest, openSocketTest)
     NextCharacter letter = src.getCurrentCharacter();
     EXPECT_EQ(letter.nextLetter, 't');
     EXPECT_EQ(letter.absolutePosition, 0);
-    EXPECT_EQ(letter.characterPosition, 0);
-    EXPECT_EQ(letter.linePosition, 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 0);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
     letter = src.getChar();
     EXPECT_EQ(letter.nextLetter, 'e');
     EXPECT_EQ(letter.absolutePosition, 1);
-    EXPECT_EQ(letter.characterPosition, 1);
-    EXPECT_EQ(letter.linePosition, 0);
-}
\ No newline at end of file
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getChar(), 1);
+    EXPECT_EQ(src.resolvePosition(letter.absolutePosition).getLine(), 0);
+}
+
+TEST(SourceTest, socketBufferedReadTest)
+{
+    std::string longSample;
+    for (int i = 0; i < 1024; ++i)
+        longSample += "line " + std::to_string(i) + "\n";
+    std::thread thread2([&] {
+      {
+        using namespace std::chrono_literals;
+        std::this_thread::sleep_for(1000ms);
+      }
+        ClientTCP::run(longSample.c_str(), 35555);
+    });
+    SocketSource src;
+    thread2.join();
+    src.open();
+    std::string received;
+    NextCharacter letter = src.getCurrentCharacter();
+    while (letter.nextLetter != '\0')
+    {
+        received += letter.nextLetter;
+        letter = src.getChar();
+    }
+    EXPECT_EQ(received, longSample);
+    EXPECT_EQ(letter.absolutePosition, longSample.size());
+    EXPECT_LT(src.getReadCalls(), longSample.size() / 1024);
+    letter = src.getChar();
+    EXPECT_EQ(letter.nextLetter, '\0');
+}
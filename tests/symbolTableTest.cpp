@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/symbolTable.hpp"
+
+TEST(SymbolTableTest, internTest)
+{
+    SymbolTable table;
+    Symbol first = table.intern("counter");
+    Symbol second = table.intern("matrix1");
+    Symbol again = table.intern(std::string("counter"));
+    EXPECT_EQ(first.id, 0);
+    EXPECT_EQ(second.id, 1);
+    EXPECT_EQ(again.id, first.id);
+    EXPECT_EQ(again.text.data(), first.text.data());
+    EXPECT_EQ(table.getText(second.id), "matrix1");
+    EXPECT_EQ(table.size(), 2);
+}
+
+TEST(SymbolTableTest, stableTextTest)
+{
+    SymbolTable table;
+    Symbol first = table.intern("a_rather_long_identifier_name");
+    for (int i = 0; i < 10000; ++i)
+        table.intern("identifier" + std::to_string(i));
+    EXPECT_EQ(first.text, "a_rather_long_identifier_name");
+    EXPECT_EQ(table.getText(5001), "identifier5000");
+}
+
+TEST(SymbolTableTest, separateTablesTest)
+{
+    SymbolTable first;
+    SymbolTable second;
+    Symbol x = first.intern("x");
+    Symbol y = second.intern("y");
+    EXPECT_EQ(x.id, y.id);
+    EXPECT_NE(x, y);
+    EXPECT_EQ(x, second.intern("x"));
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "lexical_analyzer/tokenCache.hpp"
+#include "helpers/hash.hpp"
+#include "testPrograms.hpp"
+
+namespace
+{
+    const std::string &code = TestPrograms::function;
+
+    std::filesystem::path cacheDirectory()
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "tkomTokenCacheTest";
+        std::filesystem::remove_all(directory);
+        return directory;
+    }
+
+    void patchEntry(const std::filesystem::path &path, uint64_t position, uint64_t value)
+    {
+        std::fstream entry(path, std::ios::binary | std::ios::in | std::ios::out);
+        entry.seekp(position);
+        entry.write(reinterpret_cast<const char *>(&value), sizeof value);
+    }
+}
+
+TEST(TokenCacheTest, xxHash64Test)
+{
+    EXPECT_EQ(Hash::xxHash64(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(Hash::xxHash64("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(Hash::xxHash64("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(TokenCacheTest, missThenHitTest)
+{
+    TokenCache tokenCache(cacheDirectory());
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    CachedTokenStreamUptr stored = tokenCache.tokenize(code);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_TRUE(std::filesystem::exists(tokenCache.getEntryPath(code)));
+    CachedTokenStreamUptr cached = tokenCache.load(code);
+    ASSERT_NE(cached, nullptr);
+
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenStream stream = lexicAna.tokenizeAll();
+    ASSERT_EQ(cached->size(), stream.size());
+    for (size_t i = 0; i < stream.size(); ++i)
+    {
+        EXPECT_EQ(cached->getTypes()[i], stream.getTypes()[i]);
+        EXPECT_EQ(cached->getSubtypes()[i], stream.getSubtypes()[i]);
+        EXPECT_EQ(cached->getOffsets()[i], stream.getOffsets()[i]);
+        EXPECT_EQ(cached->getPayloadKinds()[i], stream.getPayloadKinds()[i]);
+        EXPECT_EQ(cached->getPayloads()[i], stream.getPayloads()[i]);
+    }
+    EXPECT_EQ(cached->getSymbolCount(), lexicAna.getSymbolTable().size());
+    EXPECT_EQ(cached->getIndentCount(), stream.getTables()->indentTable.size());
+    Token identifier = cached->expand((*cached)[2]);
+    EXPECT_EQ(identifier.getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(std::get<std::string>(identifier.getValue()), "compute");
+    Token open = cached->expand((*cached)[9]);
+    EXPECT_EQ(open.getType(), Token::TokenType::OpenBlockToken);
+    EXPECT_EQ(std::get<std::string>(open.getValue()), "    ");
+}
+
+TEST(TokenCacheTest, keyTest)
+{
+    std::filesystem::path directory = cacheDirectory();
+    TokenCache tokenCache(directory);
+    tokenCache.tokenize(code);
+    EXPECT_EQ(tokenCache.load(code + "\n"), nullptr);
+    TokenCache discardingCache(directory, LexicalAnalyzer::CommentMode::Discard);
+    EXPECT_EQ(discardingCache.load(code), nullptr);
+    CachedTokenStreamUptr discarded = discardingCache.tokenize(code);
+    EXPECT_EQ(std::count(discarded->getTypes().begin(), discarded->getTypes().end(), Token::TokenType::CommentToken), 0);
+    EXPECT_NE(tokenCache.load(code), nullptr);
+}
+
+TEST(TokenCacheTest, damagedEntryTest)
+{
+    TokenCache tokenCache(cacheDirectory());
+    tokenCache.tokenize(code);
+    std::filesystem::path path = tokenCache.getEntryPath(code);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    std::ofstream(path, std::ios::trunc) << "TKOM";
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    EXPECT_NE(tokenCache.tokenize(code), nullptr);
+    EXPECT_NE(tokenCache.load(code), nullptr);
+}
+
+TEST(TokenCacheTest, damagedSymbolsTest)
+{
+    const uint64_t headerSize = 64;
+    TokenCache tokenCache(cacheDirectory());
+    CachedTokenStreamUptr cached = tokenCache.tokenize(code);
+    std::filesystem::path path = tokenCache.getEntryPath(code);
+    uint64_t symbolEnds = headerSize + cached->size() * sizeof(uint64_t);
+    uint64_t symbolCount = cached->getSymbolCount();
+    cached.reset();
+
+    patchEntry(path, headerSize + 2 * sizeof(uint64_t), symbolCount);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    tokenCache.tokenize(code);
+    patchEntry(path, symbolEnds, UINT64_MAX);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    tokenCache.tokenize(code);
+    patchEntry(path, symbolEnds + sizeof(uint64_t), 0);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    EXPECT_NE(tokenCache.tokenize(code), nullptr);
+    EXPECT_NE(tokenCache.load(code), nullptr);
+}
+
+TEST(TokenCacheTest, damagedTextSizeTest)
+{
+    const uint64_t tokenCountPosition = 32;
+    const uint64_t textSizePosition = 48;
+    const uint64_t bytesPerToken = sizeof(uint64_t) + sizeof(uint32_t) + 3;
+    TokenCache tokenCache(cacheDirectory());
+    CachedTokenStreamUptr cached = tokenCache.tokenize(code);
+    std::filesystem::path path = tokenCache.getEntryPath(code);
+    uint64_t tokenCount = cached->size();
+    uint64_t textCount = cached->getSymbolCount() + cached->getIndentCount();
+    uint64_t textSize = std::filesystem::file_size(path) - 64 - tokenCount * bytesPerToken - textCount * sizeof(uint64_t);
+    cached.reset();
+
+    patchEntry(path, textSizePosition, UINT64_MAX);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    tokenCache.tokenize(code);
+    // Grows the token columns by textSize tokens and lets textSize wrap so the entry size still matches the file.
+    patchEntry(path, tokenCountPosition, tokenCount + textSize);
+    patchEntry(path, textSizePosition, textSize - textSize * bytesPerToken);
+    EXPECT_EQ(tokenCache.load(code), nullptr);
+    EXPECT_NE(tokenCache.tokenize(code), nullptr);
+    EXPECT_NE(tokenCache.load(code), nullptr);
+}
+
+TEST(TokenCacheTest, lexicalErrorTest)
+{
+    TokenCache tokenCache(cacheDirectory());
+    EXPECT_THROW(tokenCache.tokenize("text label = 'open\n"), WronglyDefinedStringLiteral);
+    EXPECT_FALSE(std::filesystem::exists(tokenCache.getEntryPath("text label = 'open\n")));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/tokenGenerator.hpp"
+#include "testPrograms.hpp"
+
+namespace
+{
+    const std::string code = TestPrograms::function + "x = [1, 2; 3, 4]";
+
+    std::vector<Token> lexWhole(const std::string &program)
+    {
+        StringSource src(program);
+        LexicalAnalyzer lexicAna(src);
+        std::vector<Token> tokens;
+        do
+            tokens.push_back(*lexicAna.getToken());
+        while (tokens.back().getType() != Token::TokenType::EndOfFileToken);
+        return tokens;
+    }
+
+    void expectSameTokens(const std::vector<Token> &tokens, const std::vector<Token> &expected)
+    {
+        ASSERT_EQ(tokens.size(), expected.size());
+        for (size_t i = 0; i < tokens.size(); ++i)
+        {
+            EXPECT_EQ(tokens[i], expected[i]) << "token " << i;
+            EXPECT_EQ(tokens[i].getAbsolutePosition(), expected[i].getAbsolutePosition()) << "token " << i;
+        }
+    }
+}
+
+TEST(TokenGeneratorTest, byteByByteFeedTest)
+{
+    TokenFeed feed;
+    std::vector<Token> tokens;
+    for (char letter : code)
+    {
+        feed.push(std::string_view(&letter, 1));
+        while (std::optional<Token> token = feed.next())
+            tokens.push_back(std::move(*token));
+    }
+    EXPECT_FALSE(feed.done());
+    feed.finish();
+    while (std::optional<Token> token = feed.next())
+        tokens.push_back(std::move(*token));
+    EXPECT_TRUE(feed.done());
+    expectSameTokens(tokens, lexWhole(code));
+    EXPECT_EQ(feed.resolvePosition(code.find("return")).getLine(), 4);
+}
+
+TEST(TokenGeneratorTest, waitsForCompleteLineTest)
+{
+    TokenFeed feed;
+    feed.push("alpha = beta");
+    EXPECT_FALSE(feed.next());
+    feed.push("\n");
+    EXPECT_FALSE(feed.next());
+    feed.push("g");
+    std::vector<Token::TokenType> types;
+    while (std::optional<Token> token = feed.next())
+        types.push_back(token->getType());
+    EXPECT_EQ(types, (std::vector<Token::TokenType>{Token::TokenType::IdentifierToken,
+                                                    Token::TokenType::AssignmentOperatorToken,
+                                                    Token::TokenType::IdentifierToken,
+                                                    Token::TokenType::NextLineToken}));
+    feed.push("amma\n");
+    feed.finish();
+    std::optional<Token> gamma = feed.next();
+    ASSERT_TRUE(gamma);
+    EXPECT_EQ(std::get<std::string>(gamma->getValue()), "gamma");
+    EXPECT_EQ(feed.next()->getType(), Token::TokenType::NextLineToken);
+    EXPECT_EQ(feed.next()->getType(), Token::TokenType::EndOfFileToken);
+    EXPECT_FALSE(feed.next());
+    EXPECT_TRUE(feed.done());
+    EXPECT_THROW(feed.push("more"), FeedClosedException);
+}
+
+TEST(TokenGeneratorTest, interleavedFeedsTest)
+{
+    std::string other = "if(a):\n\tb = 'tab'\nc = 3\n";
+    TokenFeed first;
+    TokenFeed second(LexicalAnalyzer::CommentMode::Discard);
+    std::vector<Token> firstTokens;
+    std::vector<Token> secondTokens;
+    for (size_t offset = 0; offset < std::max(code.size(), other.size()); offset += 5)
+    {
+        if (offset < code.size())
+            first.push(std::string_view(code).substr(offset, 5));
+        if (offset < other.size())
+            second.push(std::string_view(other).substr(offset, 5));
+        while (std::optional<Token> token = second.next())
+            secondTokens.push_back(std::move(*token));
+        while (std::optional<Token> token = first.next())
+            firstTokens.push_back(std::move(*token));
+    }
+    first.finish();
+    second.finish();
+    while (std::optional<Token> token = first.next())
+        firstTokens.push_back(std::move(*token));
+    while (std::optional<Token> token = second.next())
+        secondTokens.push_back(std::move(*token));
+    expectSameTokens(firstTokens, lexWhole(code));
+    expectSameTokens(secondTokens, lexWhole(other));
+}
+
+TEST(TokenGeneratorTest, largeFeedTest)
+{
+    std::string program;
+    for (int i = 0; i < 20000; ++i)
+        program += "value" + std::to_string(i % 97) + " = 'text' + " + std::to_string(i) + "\n";
+    TokenFeed feed;
+    std::vector<Token> tokens;
+    for (size_t offset = 0; offset < program.size(); offset += 4093)
+    {
+        feed.push(std::string_view(program).substr(offset, 4093));
+        while (std::optional<Token> token = feed.next())
+            tokens.push_back(std::move(*token));
+    }
+    feed.finish();
+    while (std::optional<Token> token = feed.next())
+        tokens.push_back(std::move(*token));
+    expectSameTokens(tokens, lexWhole(program));
+}
+
+TEST(TokenGeneratorTest, errorModesTest)
+{
+    TokenFeed throwing;
+    throwing.push("label = 'open\nx = 1\n");
+    EXPECT_EQ(throwing.next()->getType(), Token::TokenType::IdentifierToken);
+    EXPECT_EQ(throwing.next()->getType(), Token::TokenType::AssignmentOperatorToken);
+    EXPECT_THROW(throwing.next(), WronglyDefinedStringLiteral);
+    EXPECT_TRUE(throwing.done());
+    EXPECT_FALSE(throwing.next());
+
+    TokenFeed collecting(LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Collect);
+    collecting.push("label = 'open\nx = 1\n");
+    collecting.finish();
+    std::vector<Token::TokenType> types;
+    while (std::optional<Token> token = collecting.next())
+        types.push_back(token->getType());
+    EXPECT_EQ(std::count(types.begin(), types.end(), Token::TokenType::ErrorToken), 1);
+    EXPECT_EQ(types.back(), Token::TokenType::EndOfFileToken);
+}
+
+TEST(TokenGeneratorTest, pullSourceGeneratorTest)
+{
+    StringSource src(code);
+    TokenGenerator generator = generateTokens(src);
+    std::vector<Token> tokens;
+    while (std::optional<Token> token = generator.next())
+        tokens.push_back(std::move(*token));
+    EXPECT_TRUE(generator.done());
+    expectSameTokens(tokens, lexWhole(code));
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/tokenLookahead.hpp"
+
+TEST(TokenLookaheadTest, peekAndConsumeTest)
+{
+    std::string code = "a = b + 1\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenLookahead<4> lookahead(lexicAna);
+    EXPECT_EQ(lookahead.peek(3).getType(), Token::TokenType::AdditiveOperatorToken);
+    EXPECT_EQ(lookahead.peek(1).getType(), Token::TokenType::AssignmentOperatorToken);
+    EXPECT_EQ(std::get<std::string>(lookahead.consume().getValue()), "a");
+    EXPECT_EQ(lookahead.consume().getType(), Token::TokenType::AssignmentOperatorToken);
+    EXPECT_EQ(std::get<int64_t>(lookahead.peek(2).getValue()), 1);
+    lookahead.consume();
+    lookahead.consume();
+    EXPECT_EQ(std::get<int64_t>(lookahead.consume().getValue()), 1);
+    EXPECT_EQ(lookahead.consume().getType(), Token::TokenType::NextLineToken);
+    EXPECT_EQ(lookahead.consume().getType(), Token::TokenType::EndOfFileToken);
+    EXPECT_EQ(lookahead.peek(2).getType(), Token::TokenType::EndOfFileToken);
+    EXPECT_EQ(lookahead.getPosition(), 7);
+}
+
+TEST(TokenLookaheadTest, markAndRewindTest)
+{
+    std::string code = "f(x, y)\ng[1]\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenLookahead<8> lookahead(lexicAna);
+    lookahead.mark();
+    lookahead.consume();
+    lookahead.consume();
+    lookahead.mark();
+    EXPECT_EQ(std::get<std::string>(lookahead.consume().getValue()), "x");
+    lookahead.rewind();
+    EXPECT_EQ(std::get<std::string>(lookahead.consume().getValue()), "x");
+    lookahead.rewind();
+    EXPECT_EQ(lookahead.getPosition(), 0);
+    EXPECT_EQ(std::get<std::string>(lookahead.peek().getValue()), "f");
+    for (int i = 0; i < 7; ++i)
+        lookahead.consume();
+    lookahead.mark();
+    lookahead.consume();
+    lookahead.release();
+    EXPECT_EQ(lookahead.consume().getType(), Token::TokenType::OpenSquareBracketToken);
+    EXPECT_THROW(lookahead.rewind(), LookaheadOutOfRange);
+}
+
+TEST(TokenLookaheadTest, windowTest)
+{
+    std::string code = "a b c d e f g h\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenLookahead<4> lookahead(lexicAna);
+    EXPECT_THROW(lookahead.peek(4), LookaheadOutOfRange);
+    lookahead.mark();
+    lookahead.consume();
+    lookahead.consume();
+    EXPECT_EQ(std::get<std::string>(lookahead.peek(1).getValue()), "d");
+    EXPECT_THROW(lookahead.peek(2), LookaheadOutOfRange);
+    lookahead.rewind();
+    EXPECT_EQ(std::get<std::string>(lookahead.consume().getValue()), "a");
+    EXPECT_EQ(std::get<std::string>(lookahead.peek(2).getValue()), "d");
+    EXPECT_THROW(lookahead.peek(3), LookaheadOutOfRange);
+}
+
+TEST(TokenLookaheadTest, consumedTokenSurvivesPeekTest)
+{
+    std::string code = "a b c d e f g h\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenLookahead<4> lookahead(lexicAna);
+    const Token &consumed = lookahead.consume();
+    EXPECT_EQ(std::get<std::string>(lookahead.peek(2).getValue()), "d");
+    EXPECT_THROW(lookahead.peek(3), LookaheadOutOfRange);
+    EXPECT_EQ(std::get<std::string>(consumed.getValue()), "a");
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/tokenPipeline.hpp"
+#include "testPrograms.hpp"
+
+TEST(SpscQueueTest, backpressureTest)
+{
+    Containers::SpscQueue<uint64_t, 4> queue;
+    const uint64_t count = 100000;
+    std::thread producer([&] {
+        for (uint64_t value = 0; value < count; ++value)
+        {
+            uint64_t pushed = value;
+            while (!queue.tryPush(pushed))
+                queue.waitWhileFull();
+        }
+    });
+    uint64_t expected = 0;
+    for (uint64_t value; expected < count; ++expected)
+    {
+        while (!queue.tryPop(value))
+            queue.waitWhileEmpty();
+        if (value != expected)
+            break;
+    }
+    producer.join();
+    EXPECT_EQ(expected, count);
+    uint64_t value;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(TokenPipelineTest, matchesLexicalAnalyzerTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(500);
+    for (size_t batchSize : std::vector<size_t>{1, 7, TokenPipeline::DEFAULT_BATCH_SIZE})
+    {
+        StringSource serialSource(program);
+        LexicalAnalyzer lexicAna(serialSource);
+        StringSource pipelinedSource(program);
+        TokenPipeline pipeline(pipelinedSource, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Throw,
+                               batchSize);
+        for (;;)
+        {
+            Token expected = *lexicAna.getToken();
+            Token token = *pipeline.getToken();
+            ASSERT_EQ(token, expected);
+            ASSERT_EQ(token.getAbsolutePosition(), expected.getAbsolutePosition());
+            if (expected.getType() == Token::TokenType::EndOfFileToken)
+                break;
+        }
+        EXPECT_EQ(pipeline.getToken()->getType(), Token::TokenType::EndOfFileToken);
+    }
+}
+
+TEST(TokenPipelineTest, exceptionTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(100) + "label = 'open\n" + TestPrograms::buildNestedProgram(100);
+    StringSource src(program);
+    TokenPipeline pipeline(src, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Throw, 16);
+    Token last = *pipeline.getToken();
+    EXPECT_THROW(
+        while (last.getType() != Token::TokenType::EndOfFileToken) last = *pipeline.getToken(),
+        WronglyDefinedStringLiteral);
+    EXPECT_EQ(last.getType(), Token::TokenType::AssignmentOperatorToken);
+    EXPECT_EQ(last.getAbsolutePosition(), program.find("= 'open"));
+    EXPECT_THROW(pipeline.getToken(), WronglyDefinedStringLiteral);
+}
+
+TEST(TokenPipelineTest, earlyShutdownTest)
+{
+    std::string program = TestPrograms::buildNestedProgram(5000);
+    StringSource src(program);
+    {
+        TokenPipeline pipeline(src, LexicalAnalyzer::CommentMode::Keep, LexicalAnalyzer::ErrorMode::Throw, 4);
+        EXPECT_EQ(pipeline.getToken()->getType(), Token::TokenType::FunctionToken);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    StringSource untouched(program);
+    {
+        TokenPipeline pipeline(untouched);
+    }
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "lexical_analyzer/lexicalAnalyzer.hpp"
+
+TEST(TokenStreamTest, tokenizeAllTest)
+{
+    std::string code = "integer age = 21\nif(age >= 18):\n    text label = 'adult'\n";
+    StringSource src(code);
+    LexicalAnalyzer lexicAna(src);
+    TokenStream stream = lexicAna.tokenizeAll();
+    StringSource referenceSrc(code);
+    LexicalAnalyzer referenceAna(referenceSrc);
+    for (size_t i = 0; i < stream.size(); ++i)
+    {
+        std::optional<Token> token = referenceAna.getToken();
+        Token expanded = lexicAna.expand(stream[i]);
+        EXPECT_EQ(stream.getTypes()[i], token->getType());
+        EXPECT_EQ(stream.getOffsets()[i], token->getAbsolutePosition());
+        EXPECT_EQ(expanded.getValue(), token->getValue());
+    }
+    EXPECT_EQ(stream.size(), 20);
+    EXPECT_EQ(stream.getTypes().back(), Token::TokenType::EndOfFileToken);
+}
+
+TEST(TokenStreamTest, reuseStreamTest)
+{
+    StringSource src("a = 1\n");
+    LexicalAnalyzer lexicAna(src);
+    TokenStream stream;
+    lexicAna.tokenizeAll(stream);
+    EXPECT_EQ(stream.size(), 5);
+    EXPECT_EQ(std::get<int64_t>(lexicAna.expand(stream[2]).getValue()), 1);
+    StringSource secondSrc("b\n");
+    LexicalAnalyzer secondAna(secondSrc);
+    secondAna.tokenizeAll(stream);
+    EXPECT_EQ(stream.size(), 3);
+    EXPECT_EQ(std::get<std::string>(secondAna.expand(stream[0]).getValue()), "b");
+}
+
+TEST(TokenStreamTest, outlivesAnalyzerTest)
+{
+    StringSource src("label = 'text'\nvalue = 0.5 + 12\n");
+    TokenStream stream;
+    {
+        LexicalAnalyzer lexicAna(src);
+        lexicAna.tokenizeAll(stream);
+    }
+    EXPECT_EQ(std::get<std::string>(stream.expand(0).getValue()), "label");
+    EXPECT_EQ(std::get<std::string>(stream.expand(2).getValue()), "text");
+    EXPECT_EQ(std::get<double>(stream.expand(6).getValue()), 0.5);
+    EXPECT_EQ(std::get<int64_t>(stream.expand(8).getValue()), 12);
+    EXPECT_EQ(stream.expand(8).getAbsolutePosition(), 29);
+    TokenStream detached;
+    detached.push(stream[0]);
+    EXPECT_THROW(detached.expand(0), TokenStreamException);
+}